@@ -12,21 +12,116 @@
 #include <stdio.h>
 #include <time.h>
 #include <string.h>
+#include "motor.h"   // Bitboards, avaliação e busca da IA (define LINHAS e COLUNAS)
+#include "playout.h" // Partidas aleatórias para Monte Carlo
+#include "rede_neural.h" // Avaliador opcional por rede neural
+#include "cache_disco.h" // Cache persistente de posições resolvidas
+#include "mcts.h"        // Busca Monte Carlo em árvore sobre uma arena de nós
+#include "prova.h"       // Busca por números de prova para posições táticas
+#include "banco_solucao.h" // Solução completa pré-calculada dos tabuleiros pequenos
+#include "sprites.h"       // Atlas das fichas e desenho em lote
+#include "ritmo.h"         // Ritmo de quadros (VSync ou limite) e medição de jitter
+#include "painel.h"        // Painel de desempenho (F3)
+#include "torneio.h"       // Partidas de autojogo simultâneas do modo espectador
+#include <SDL2/SDL_test_crc32.h>
+#include <SDL2/SDL_test_md5.h>
 
-#define LINHAS 6     // Número de linhas do tabuleiro
-#define COLUNAS 7    // Número de colunas do tabuleiro
+#define LARGURA_LOGICA 900 // Tamanho da tela em que o layout foi desenhado (o das imagens); a janela é escalada a partir dele
+#define ALTURA_LOGICA 614
 #define MAX_ANIMACOES 10 // Número máximo de animações simultâneas de peças caindo
+#define PASSO_ANIMACAO_S (1.0 / 120.0) // Passo fixo da simulação da queda, independente dos quadros
+#define VELOCIDADE_QUEDA 1000.0f    // Velocidade da peça caindo, em pixels por segundo
+#define ATRASO_MAXIMO_S 0.25        // Tempo máximo simulado de uma vez (depois de a janela travar, por exemplo)
+#define PAUSA_IA_MS 500     // Espera antes de a IA começar a pensar (efeito visual)
+#define PROFUNDIDADE_IA 12  // Profundidade máxima da busca da IA (em jogadas)
+#define TEMPO_IA_MS 1000    // Prazo de cada jogada da IA; a busca para nele mesmo sem chegar à profundidade máxima
+#define TAMANHO_TT_MB 16    // Memória da tabela de transposição da IA
+#define TAMANHO_PROVA_MB 64 // Memória da tabela de nós da busca por números de prova
+#define ARQUIVO_REDE "rede_c4.bin" // Pesos da rede neural (opcional; sem o arquivo, usa a avaliação manual)
+#define ARQUIVO_CACHE "analises_c4.cache" // Cache em disco padrão (usado com --cache)
+#define TAMANHO_CACHE_MB 64 // Tamanho de um cache em disco novo
+#define QUADROS_SEM_JANELA 600 // Quadros desenhados no modo sem janela (padrão)
+#define QUADROS_TELA_FINAL 10  // Quadros da tela de vitória no roteiro do modo sem janela
+#define PARTIDAS_TORNEIO 16    // Partidas no modo espectador (padrão)
+#define MS_JOGADA_TORNEIO 50   // Prazo de cada lance das partidas do modo espectador (padrão)
+#define MARGEM_TORNEIO 4       // Espaço lógico entre o tabuleiro e a borda da sua célula na grade
+#define FORMATO_ARQUIVO_SOLUCAO "solucao_%dx%d.c4sb" // Banco de solução do tabuleiro (COLUNAS x LINHAS), se existir
 
-// Coordenadas dos centros das casas do tabuleiro, conforme o layout da imagem de fundo
-const int centros_x[COLUNAS] = {257, 311, 365, 419, 473, 527, 581};
-const int centros_y[LINHAS]  = {188, 242, 296, 350, 404, 458};
+/*
+    Geometria da imagem do tabuleiro, em coordenadas lógicas. A imagem é
+    desenhada em escala 1 na tela lógica (1 unidade = 1 pixel do PNG) e o
+    canto dela fica onde estava na tela original de 900x614; quem adapta
+    tudo ao tamanho da janela é a escala do renderizador, não estas medidas.
+    Tabuleiros menores usam só parte da imagem (ver calcular_layout).
+*/
+#define TABULEIRO_X 200        // Canto da imagem inteira na tela lógica
+#define TABULEIRO_Y 150
+#define LARGURA_IMAGEM_TABULEIRO 447
+#define ALTURA_IMAGEM_TABULEIRO 358
+#define COLUNAS_IMAGEM 7
+#define LINHAS_IMAGEM 6
+#define ESPACO_CASA 54         // Distância entre os centros de duas casas vizinhas
+#define PRIMEIRA_CASA_X 57     // Centro da casa de cima à esquerda, a partir do canto da imagem
+#define PRIMEIRA_CASA_Y 38
+#define MAX_PEDACOS 4          // Pedaços da imagem que formam o tabuleiro (até dois por eixo)
+#if COLUNAS > COLUNAS_IMAGEM || LINHAS > LINHAS_IMAGEM
+#error "A imagem do tabuleiro tem só 7x6 casas"
+#endif
 const int raio_ficha = 25; // Raio da ficha, usado para desenhar as peças
 
+// Ações dos botões das telas de menu e final
+typedef enum {
+    BOTAO_JOGAR_IA,
+    BOTAO_JOGAR_PVP,
+    BOTAO_MENU,
+    BOTAO_SAIR
+} AcaoBotao;
+
+typedef struct {
+    SDL_Rect area; // Em coordenadas lógicas, conforme as imagens das telas
+    AcaoBotao acao;
+} Botao;
+
+const Botao botoes_menu[] = {
+    {{299, 282, 287, 54}, BOTAO_JOGAR_IA},
+    {{301, 403, 285, 47}, BOTAO_JOGAR_PVP},
+    {{294, 516, 292, 51}, BOTAO_SAIR},
+};
+const Botao botoes_final[] = {
+    {{276, 368, 325, 53}, BOTAO_MENU},
+    {{276, 448, 325, 59}, BOTAO_SAIR},
+};
+#define NUM_BOTOES(botoes) ((int)(sizeof(botoes) / sizeof(botoes[0])))
+
+/*
+    Tabela de layout, refeita só quando o tamanho da saída muda. O desenho
+    e os cliques usam coordenadas lógicas (LARGURA_LOGICA x ALTURA_LOGICA):
+    SDL_RenderSetLogicalSize escala o desenho para a janela, com faixas nas
+    bordas se a proporção for outra, e converte as posições do mouse de volta
+    com a mesma escala. A camada do tabuleiro é criada no tamanho real em
+    pixels, para não ser ampliada depois de pronta.
+*/
+typedef struct {
+    float escala;                     // Pixels de saída por unidade lógica
+    int centros_x[COLUNAS];           // Centros das casas
+    int centros_y[LINHAS];
+    SDL_Rect tabuleiro;               // Onde o tabuleiro é desenhado (contém todas as casas)
+    int num_pedacos;                  // Pedaços da imagem que formam o tabuleiro (1 = imagem inteira)
+    SDL_FRect recortes[MAX_PEDACOS];  // Parte da imagem de cada pedaço, em frações do tamanho dela
+    SDL_Rect pedacos[MAX_PEDACOS];    // Onde cada pedaço vai, a partir do canto do tabuleiro
+    SDL_FRect casas[LINHAS][COLUNAS]; // Retângulo de cada ficha parada
+    SDL_Rect colunas[COLUNAS];        // Área clicável de cada coluna
+    int largura_camada, altura_camada; // Tamanho em pixels da textura da camada do tabuleiro
+} Layout;
+
+Layout layout;
+
 // Estrutura que representa uma animação de peça caindo
 typedef struct {
     int coluna;         // Coluna da peça
     int linha_final;    // Linha onde a peça irá parar
-    float y_atual;      // Posição vertical atual da peça (para animação)
+    float y_atual;      // Posição vertical no passo atual da simulação
+    float y_anterior;   // Posição no passo anterior (o desenho interpola entre as duas)
     int jogador;        // Jogador dono da peça (1 ou 2)
     bool ativa;         // Se a animação está ativa
 } AnimacaoPeca;
@@ -34,6 +129,10 @@ typedef struct {
 // Vetor global de animações de peças caindo
 AnimacaoPeca animacoes[MAX_ANIMACOES] = {0};
 
+// Relógio da simulação: o tempo real decorrido entra no acumulador e sai em passos de PASSO_ANIMACAO_S
+Uint64 relogio_animacao = 0;
+double acumulador_animacao = 0;
+
 // Tabuleiro virtual: 0 = vazio, 1 = jogador 1, 2 = jogador 2
 int tabuleiro_virtual[LINHAS][COLUNAS] = {0};
 
@@ -48,6 +147,24 @@ typedef enum {
 EstadoJogo estado_atual = MENU; // Estado atual do jogo
 int jogador_vencedor = 0;       // Armazena o vencedor da partida (1 ou 2)
 
+TabelaTransposicao tabela_ia;   // Tabela de transposição usada pela IA
+RedeNeural rede_ia;             // Rede neural da IA, quando ARQUIVO_REDE existe
+CacheDisco cache_ia;            // Cache em disco da IA (vazio sem --cache)
+BancoSolucao solucao_ia;        // Banco de solução completa (vazio se o arquivo do tabuleiro não existir)
+
+// A IA pensa em uma thread separada para a janela continuar respondendo
+SDL_Thread* thread_ia = NULL;   // Busca em andamento (NULL = nenhuma)
+SDL_atomic_t ia_terminou;       // 1 quando coluna_ia_calculada está pronta
+SDL_atomic_t parada_ia;         // Pedido de parada da busca da IA (zerado antes de criar a thread)
+Posicao posicao_ia;             // Cópia da posição entregue à thread
+int coluna_ia_calculada = -1;
+Uint32 evento_ia_pronta = (Uint32)-1; // Evento que acorda o laço principal quando a IA termina
+Uint32 inicio_busca_ia = 0;     // SDL_GetTicks() quando a thread começou a pensar
+
+// Última jogada da IA, para o painel de desempenho (escritas pela thread, lidas depois de ela terminar)
+const char* origem_jogada_ia = NULL; // "banco", "cache", "forcada" ou "busca" (NULL antes da primeira)
+EstatisticasBusca busca_ia;          // Estatísticas da última busca, quando origem_jogada_ia é "busca"
+
 /*
     Função para checar se um jogador venceu o jogo.
     Verifica todas as posições do tabuleiro para encontrar 4 peças consecutivas
@@ -102,21 +219,91 @@ int encontrar_linha_disponivel(int coluna) {
 }
 
 /*
-    Função simples de IA: escolhe uma coluna aleatória válida para jogar.
-    Retorna o índice da coluna escolhida, ou -1 se não houver opções.
+    IA: busca a melhor jogada para o jogador 2 com alfa-beta, limitada a
+    TEMPO_IA_MS (ou joga direto quando a jogada é forçada). Retorna o índice da coluna escolhida, ou -1 se não houver opções.
 */
-int escolher_coluna_ia() {
-    int colunas_validas[COLUNAS];
-    int num_validas = 0;
-    // Monta lista de colunas não-cheias
-    for (int j = 0; j < COLUNAS; j++) {
-        if (encontrar_linha_disponivel(j) != -1) {
-            colunas_validas[num_validas++] = j;
-        }
+int escolher_coluna_ia(const Posicao* posicao) {
+    Posicao p = *posicao;
+    int pontuacao, coluna;
+
+    // Tabuleiro pequeno com banco de solução: a jogada perfeita sai de uma consulta, sem busca
+    if (solucao_melhor_jogada(&solucao_ia, &p, &coluna, &pontuacao)) {
+        SDL_Log("IA: coluna %d do banco de solucao (pontuacao %d)", coluna, pontuacao);
+        origem_jogada_ia = "banco";
+        return coluna;
+    }
+
+    // Posição já resolvida nesta ou em outra execução: não precisa buscar de novo
+    if (cache_consultar(&cache_ia, &p, &pontuacao, &coluna)) {
+        SDL_Log("IA: coluna %d do cache em disco (pontuacao %d)", coluna, pontuacao);
+        origem_jogada_ia = "cache";
+        return coluna;
+    }
+
+    ResultadoBusca r = buscar_jogada_com_prazo(&p, PROFUNDIDADE_IA, TEMPO_IA_MS, &tabela_ia, &parada_ia);
+    if (r.forcada) SDL_Log("IA: jogada forcada na coluna %d (sem busca)", r.coluna);
+    else registrar_estatisticas(&r.estatisticas);
+    origem_jogada_ia = r.forcada ? "forcada" : "busca";
+    busca_ia = r.estatisticas;
+    if (r.resolvida) cache_gravar(&cache_ia, &p, r.pontuacao, r.coluna);
+    return r.coluna;
+}
+
+// Corpo da thread da IA: busca na cópia da posição e avisa o laço principal
+int pensar_ia(void* dados) {
+    (void)dados;
+    coluna_ia_calculada = escolher_coluna_ia(&posicao_ia);
+    SDL_AtomicSet(&ia_terminou, 1);
+    if (evento_ia_pronta != (Uint32)-1) {
+        SDL_Event aviso;
+        SDL_zero(aviso);
+        aviso.type = evento_ia_pronta;
+        SDL_PushEvent(&aviso);
+    }
+    return 0;
+}
+
+// Interrompe a busca em andamento (se houver) e espera a thread terminar
+void cancelar_ia() {
+    if (!thread_ia) return;
+    SDL_AtomicSet(&parada_ia, 1);
+    SDL_WaitThread(thread_ia, NULL);
+    thread_ia = NULL;
+}
+
+// Retorna true se alguma peça ainda está caindo
+bool animacao_em_andamento() {
+    for (int i = 0; i < MAX_ANIMACOES; i++)
+        if (animacoes[i].ativa) return true;
+    return false;
+}
+
+// Número de peças caindo agora
+int contar_animacoes() {
+    int n = 0;
+    for (int i = 0; i < MAX_ANIMACOES; i++)
+        if (animacoes[i].ativa) n++;
+    return n;
+}
+
+/*
+    Descreve em uma linha o que a IA está fazendo, para o painel de desempenho:
+    pausa antes de pensar, busca em andamento (com o tempo decorrido) ou o
+    resultado da última jogada.
+*/
+void descrever_ia(char* texto, size_t tamanho, Uint32 inicio_pausa_ia) {
+    if (thread_ia) {
+        snprintf(texto, tamanho, "pensando %u ms", (unsigned)(SDL_GetTicks() - inicio_busca_ia));
+    } else if (inicio_pausa_ia) {
+        snprintf(texto, tamanho, "pausa antes de pensar");
+    } else if (!origem_jogada_ia) {
+        snprintf(texto, tamanho, "parada");
+    } else if (strcmp(origem_jogada_ia, "busca") == 0) {
+        snprintf(texto, tamanho, "prof %d, %.0fk nos, %.0f ms%s", busca_ia.profundidade, (double)busca_ia.nos / 1000.0,
+                 busca_ia.segundos * 1000.0, busca_ia.interrompida ? " (prazo)" : "");
+    } else {
+        snprintf(texto, tamanho, "ultima jogada: %s", origem_jogada_ia);
     }
-    if (num_validas == 0) return -1;
-    // Escolhe aleatoriamente entre as válidas
-    return colunas_validas[rand() % num_validas];
 }
 
 /*
@@ -124,11 +311,17 @@ int escolher_coluna_ia() {
     Busca um slot livre no vetor de animações.
 */
 void iniciar_animacao(int coluna, int linha, int jogador) {
+    // Primeira peça caindo: o relógio da simulação começa agora
+    if (!animacao_em_andamento()) {
+        relogio_animacao = SDL_GetPerformanceCounter();
+        acumulador_animacao = 0;
+    }
     for (int i = 0; i < MAX_ANIMACOES; i++) {
         if (!animacoes[i].ativa) {
             animacoes[i].coluna = coluna;
             animacoes[i].linha_final = linha;
-            animacoes[i].y_atual = centros_y[0] - raio_ficha * 2; // Inicia acima do topo
+            animacoes[i].y_atual = layout.centros_y[0] - raio_ficha * 2; // Inicia acima do topo
+            animacoes[i].y_anterior = animacoes[i].y_atual;
             animacoes[i].jogador = jogador;
             animacoes[i].ativa = true;
             break;
@@ -136,35 +329,697 @@ void iniciar_animacao(int coluna, int linha, int jogador) {
     }
 }
 
+/*
+    Avança a simulação das peças caindo em um passo fixo de PASSO_ANIMACAO_S.
+    Quando uma peça chega ao destino, ela entra no tabuleiro virtual e o jogo
+    verifica vitória ou empate e passa a vez. Retorna true se alguma peça parou.
+*/
+bool simular_passo_animacoes(int* jogador_atual) {
+    bool parou = false;
+    for (int i = 0; i < MAX_ANIMACOES; i++) {
+        AnimacaoPeca* a = &animacoes[i];
+        if (!a->ativa) continue;
+        float destinoY = layout.centros_y[a->linha_final] - raio_ficha;
+        a->y_anterior = a->y_atual;
+        a->y_atual += VELOCIDADE_QUEDA * (float)PASSO_ANIMACAO_S;
+        if (a->y_atual < destinoY) continue;
+
+        // Chegou ao destino: marca a peça no tabuleiro virtual e troca jogador
+        a->y_atual = destinoY;
+        a->ativa = false;
+        parou = true;
+        tabuleiro_virtual[a->linha_final][a->coluna] = a->jogador;
+
+        // Checa vitória ou empate
+        if (checar_vitoria(a->jogador)) {
+            estado_atual = FINAL;
+            jogador_vencedor = a->jogador;
+        } else if (checar_empate()) {
+            estado_atual = MENU;
+            *jogador_atual = 1;
+            memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
+        } else {
+            // Troca o jogador (1 <-> 2)
+            *jogador_atual = 3 - a->jogador;
+        }
+    }
+    return parou;
+}
+
 /*
     Trata um clique do mouse no tabuleiro do jogo, determinando se uma peça pode ser jogada.
     Se sim, inicia a animação da peça caindo na coluna apropriada.
 */
 void tratar_clique(int mouse_x, int mouse_y, int* jogador_atual) {
-    // Define os limites do tabuleiro conforme a imagem
-    int x_ini = centros_x[0] - (centros_x[1] - centros_x[0]) / 2;
-    int x_fim = centros_x[COLUNAS-1] + (centros_x[1] - centros_x[0]) / 2;
-    int y_ini = centros_y[0] - (centros_y[1] - centros_y[0]) / 2;
-    int y_fim = centros_y[LINHAS-1] + (centros_y[1] - centros_y[0]) / 2;
-
-    // Checa se o clique está dentro do tabuleiro
-    if (mouse_x >= x_ini && mouse_x < x_fim && mouse_y >= y_ini && mouse_y < y_fim) {
-        // Descobre qual coluna foi clicada (mais próxima)
-        int coluna = 0;
-        int menor_d = abs(mouse_x - centros_x[0]);
-        for (int j = 1; j < COLUNAS; j++) {
-            int d = abs(mouse_x - centros_x[j]);
-            if (d < menor_d) {
-                menor_d = d;
-                coluna = j;
-            }
-        }
+    SDL_Point ponto = {mouse_x, mouse_y};
+    for (int coluna = 0; coluna < COLUNAS; coluna++) {
+        if (!SDL_PointInRect(&ponto, &layout.colunas[coluna])) continue;
         // Encontra a linha disponível na coluna selecionada
         int linha_disp = encontrar_linha_disponivel(coluna);
         if (linha_disp != -1) {
             iniciar_animacao(coluna, linha_disp, *jogador_atual);
         }
+        return;
+    }
+}
+
+// Retorna a ação do botão sob o ponto lógico (x, y), ou -1 se nenhum
+int botao_clicado(const Botao* botoes, int num_botoes, int x, int y) {
+    SDL_Point ponto = {x, y};
+    for (int i = 0; i < num_botoes; i++)
+        if (SDL_PointInRect(&ponto, &botoes[i].area)) return (int)botoes[i].acao;
+    return -1;
+}
+
+/*
+    Refaz a tabela de layout com a escala atual do renderizador (chamada
+    depois de SDL_RenderSetLogicalSize e a cada mudança de tamanho da saída).
+*/
+void calcular_layout(SDL_Renderer* renderer) {
+    float escala_x, escala_y;
+    SDL_RenderGetScale(renderer, &escala_x, &escala_y);
+    layout.escala = escala_x > 0 ? escala_x : 1.0f;
+
+    /*
+        Tabuleiro menor que o da imagem (compilado com -DCOLUNAS/-DLINHAS):
+        a imagem é cortada no meio do espaço depois da última coluna e da
+        última linha usadas, e a borda da direita e a de baixo são emendadas
+        ali. O tabuleiro fica centrado onde a imagem inteira ficaria.
+    */
+    int corte_x = PRIMEIRA_CASA_X + ESPACO_CASA / 2 + (COLUNAS - 1) * ESPACO_CASA;
+    int corte_y = PRIMEIRA_CASA_Y + ESPACO_CASA / 2 + (LINHAS - 1) * ESPACO_CASA;
+    int borda_x = PRIMEIRA_CASA_X + ESPACO_CASA / 2 + (COLUNAS_IMAGEM - 1) * ESPACO_CASA; // Início da borda direita
+    int borda_y = PRIMEIRA_CASA_Y + ESPACO_CASA / 2 + (LINHAS_IMAGEM - 1) * ESPACO_CASA;
+    layout.tabuleiro.w = corte_x + LARGURA_IMAGEM_TABULEIRO - borda_x;
+    layout.tabuleiro.h = corte_y + ALTURA_IMAGEM_TABULEIRO - borda_y;
+    layout.tabuleiro.x = TABULEIRO_X + (LARGURA_IMAGEM_TABULEIRO - layout.tabuleiro.w) / 2;
+    layout.tabuleiro.y = TABULEIRO_Y + (ALTURA_IMAGEM_TABULEIRO - layout.tabuleiro.h) / 2;
+
+    // Faixas [início, fim) da imagem em cada eixo; no tamanho da imagem, uma faixa só com ela inteira
+    int faixas_x[2][2] = {{0, corte_x}, {borda_x, LARGURA_IMAGEM_TABULEIRO}};
+    int faixas_y[2][2] = {{0, corte_y}, {borda_y, ALTURA_IMAGEM_TABULEIRO}};
+    int num_faixas_x = corte_x == borda_x ? 1 : 2, num_faixas_y = corte_y == borda_y ? 1 : 2;
+    if (num_faixas_x == 1) faixas_x[0][1] = LARGURA_IMAGEM_TABULEIRO;
+    if (num_faixas_y == 1) faixas_y[0][1] = ALTURA_IMAGEM_TABULEIRO;
+    layout.num_pedacos = 0;
+    for (int a = 0; a < num_faixas_y; a++) {
+        for (int b = 0; b < num_faixas_x; b++) {
+            int x0 = faixas_x[b][0], x1 = faixas_x[b][1], y0 = faixas_y[a][0], y1 = faixas_y[a][1];
+            layout.recortes[layout.num_pedacos] = (SDL_FRect){
+                (float)x0 / (float)LARGURA_IMAGEM_TABULEIRO, (float)y0 / (float)ALTURA_IMAGEM_TABULEIRO,
+                (float)(x1 - x0) / (float)LARGURA_IMAGEM_TABULEIRO, (float)(y1 - y0) / (float)ALTURA_IMAGEM_TABULEIRO};
+            layout.pedacos[layout.num_pedacos] = (SDL_Rect){b == 0 ? 0 : corte_x, a == 0 ? 0 : corte_y, x1 - x0, y1 - y0};
+            layout.num_pedacos++;
+        }
+    }
+
+    for (int j = 0; j < COLUNAS; j++) layout.centros_x[j] = layout.tabuleiro.x + PRIMEIRA_CASA_X + j * ESPACO_CASA;
+    for (int i = 0; i < LINHAS; i++) layout.centros_y[i] = layout.tabuleiro.y + PRIMEIRA_CASA_Y + i * ESPACO_CASA;
+    for (int i = 0; i < LINHAS; i++)
+        for (int j = 0; j < COLUNAS; j++)
+            layout.casas[i][j] = (SDL_FRect){(float)(layout.centros_x[j] - raio_ficha),
+                                             (float)(layout.centros_y[i] - raio_ficha),
+                                             (float)(raio_ficha * 2), (float)(raio_ficha * 2)};
+
+    // Cada coluna vai até a metade da distância para as vizinhas; na vertical, meia casa além da primeira e da última linha
+    int y_ini = layout.centros_y[0] - ESPACO_CASA / 2;
+    int y_fim = layout.centros_y[LINHAS-1] + ESPACO_CASA / 2;
+    for (int j = 0; j < COLUNAS; j++)
+        layout.colunas[j] = (SDL_Rect){layout.centros_x[j] - ESPACO_CASA / 2, y_ini, ESPACO_CASA, y_fim - y_ini};
+
+    layout.largura_camada = (int)SDL_ceilf((float)layout.tabuleiro.w * layout.escala);
+    layout.altura_camada = (int)SDL_ceilf((float)layout.tabuleiro.h * layout.escala);
+}
+
+// Desenha os pedaços da imagem do tabuleiro com o canto do tabuleiro em (x, y); retorna as chamadas de desenho
+int desenhar_imagem_tabuleiro(SDL_Renderer* renderer, SDL_Texture* imagem, int x, int y) {
+    int largura, altura;
+    if (SDL_QueryTexture(imagem, NULL, NULL, &largura, &altura) != 0) return 0;
+    for (int i = 0; i < layout.num_pedacos; i++) {
+        const SDL_FRect* r = &layout.recortes[i];
+        SDL_Rect origem = {(int)(r->x * (float)largura + 0.5f), (int)(r->y * (float)altura + 0.5f),
+                           (int)(r->w * (float)largura + 0.5f), (int)(r->h * (float)altura + 0.5f)};
+        SDL_Rect destino = {x + layout.pedacos[i].x, y + layout.pedacos[i].y, layout.pedacos[i].w, layout.pedacos[i].h};
+        SDL_RenderCopy(renderer, imagem, &origem, &destino);
+    }
+    return layout.num_pedacos;
+}
+
+/*
+    Desenha as peças já posicionadas e, por cima delas, a imagem do tabuleiro,
+    deslocadas de (-origem_x, -origem_y): (0, 0) desenha direto na tela e a
+    origem de layout.tabuleiro desenha na textura da camada do tabuleiro.
+    Retorna quantas chamadas de desenho foram feitas.
+*/
+int desenhar_pecas_e_tabuleiro(SDL_Renderer* renderer, SDL_Texture* tabuleiro, const AtlasSprites* atlas,
+                                LoteSprites* lote, int origem_x, int origem_y) {
+    // Todas as fichas em uma chamada só
+    lote_limpar(lote);
+    for (int i = 0; i < LINHAS; i++) {
+        for (int j = 0; j < COLUNAS; j++) {
+            if (tabuleiro_virtual[i][j] == 0) continue;
+            int sprite = (tabuleiro_virtual[i][j] == 1) ? SPRITE_FICHA_VERMELHA : SPRITE_FICHA_AMARELA;
+            SDL_FRect destino = layout.casas[i][j];
+            destino.x -= (float)origem_x;
+            destino.y -= (float)origem_y;
+            lote_adicionar(lote, atlas, sprite, &destino);
+        }
+    }
+    int chamadas = lote_desenhar(renderer, lote, atlas);
+    return chamadas + desenhar_imagem_tabuleiro(renderer, tabuleiro, layout.tabuleiro.x - origem_x,
+                                                layout.tabuleiro.y - origem_y);
+}
+
+// Texturas do jogo e a camada do tabuleiro, no renderizador da janela ou no de uma superfície (modo sem janela)
+typedef struct {
+    SDL_Texture* menu_img;
+    SDL_Texture* tabuleiro;
+    SDL_Texture* vencedor1;
+    SDL_Texture* vencedor2;
+    AtlasSprites atlas;          // Fichas em um atlas, desenhadas em lote
+    LoteSprites lote_fichas;     // Cabem todas as casas mais as animações
+    SDL_Texture* camada_tabuleiro;
+    int tabuleiro_na_camada[LINHAS][COLUNAS]; // Conteúdo de tabuleiro_virtual quando a camada foi desenhada
+    bool camada_valida;
+} RecursosTela;
+
+/*
+    Camada do tabuleiro: peças paradas + imagem do tabuleiro compostas em
+    uma textura alvo, refeita só quando tabuleiro_virtual muda. Como ela é
+    desenhada sobre um fundo transparente, as cores ficam pré-multiplicadas
+    pelo alfa e a cópia para a tela usa a mistura correspondente. Sem
+    suporte a texturas alvo, tudo é desenhado direto a cada quadro.
+    (Re)cria a textura no tamanho em pixels da tabela de layout, se ele mudou.
+*/
+void criar_camada(RecursosTela* tela, SDL_Renderer* renderer) {
+    int largura, altura;
+    if (tela->camada_tabuleiro && SDL_QueryTexture(tela->camada_tabuleiro, NULL, NULL, &largura, &altura) == 0 &&
+        largura == layout.largura_camada && altura == layout.altura_camada)
+        return;
+    if (tela->camada_tabuleiro) SDL_DestroyTexture(tela->camada_tabuleiro);
+    tela->camada_valida = false;
+    tela->camada_tabuleiro = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                               layout.largura_camada, layout.altura_camada);
+    if (tela->camada_tabuleiro) {
+        SDL_BlendMode pre_multiplicada = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        if (SDL_SetTextureBlendMode(tela->camada_tabuleiro, pre_multiplicada) != 0)
+            SDL_SetTextureBlendMode(tela->camada_tabuleiro, SDL_BLENDMODE_BLEND); // Bordas das fichas um pouco mais escuras
+    }
+}
+
+// Carrega as imagens e cria a camada do tabuleiro; retorna false se alguma imagem faltar
+bool carregar_recursos(RecursosTela* tela, SDL_Renderer* renderer) {
+    memset(tela, 0, sizeof(*tela));
+    tela->menu_img = IMG_LoadTexture(renderer, "imagens/menu.png");
+    tela->tabuleiro = IMG_LoadTexture(renderer, "imagens1/jogo_tabuleiro.png");
+    atlas_criar(&tela->atlas, renderer);
+    lote_criar(&tela->lote_fichas, TOTAL_CASAS + MAX_ANIMACOES);
+    tela->vencedor1 = IMG_LoadTexture(renderer, "imagens/vencedor1.png");
+    tela->vencedor2 = IMG_LoadTexture(renderer, "imagens/vencedor2.png");
+
+    criar_camada(tela, renderer);
+    return tela->menu_img && tela->tabuleiro && tela->atlas.textura && tela->vencedor1 && tela->vencedor2;
+}
+
+void liberar_recursos(RecursosTela* tela) {
+    if (tela->menu_img) SDL_DestroyTexture(tela->menu_img);
+    if (tela->tabuleiro) SDL_DestroyTexture(tela->tabuleiro);
+    lote_destruir(&tela->lote_fichas);
+    atlas_destruir(&tela->atlas);
+    if (tela->vencedor1) SDL_DestroyTexture(tela->vencedor1);
+    if (tela->vencedor2) SDL_DestroyTexture(tela->vencedor2);
+    if (tela->camada_tabuleiro) SDL_DestroyTexture(tela->camada_tabuleiro);
+    memset(tela, 0, sizeof(*tela));
+}
+
+/*
+    Desenha a tela do estado atual (menu, jogo ou vitória), com as peças
+    caindo em `interpolacao` entre o passo anterior e o atual da simulação.
+    Não apresenta o quadro. Retorna quantas chamadas de desenho foram feitas.
+*/
+int desenhar_tela(SDL_Renderer* renderer, RecursosTela* tela, float interpolacao) {
+    int chamadas = 1;
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderClear(renderer);
+
+    // Tela de menu
+    if (estado_atual == MENU) {
+        SDL_RenderCopy(renderer, tela->menu_img, NULL, NULL);
+        return chamadas + 1;
+    }
+
+    // Refaz a camada do tabuleiro se alguma peça entrou ou saiu
+    if (tela->camada_tabuleiro &&
+        (!tela->camada_valida || memcmp(tela->tabuleiro_na_camada, tabuleiro_virtual, sizeof(tabuleiro_virtual)) != 0)) {
+        SDL_SetRenderTarget(renderer, tela->camada_tabuleiro);
+        SDL_RenderSetScale(renderer, layout.escala, layout.escala); // Desenha em coordenadas lógicas; volta a 1 ao trocar de alvo
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        chamadas += 1 + desenhar_pecas_e_tabuleiro(renderer, tela->tabuleiro, &tela->atlas, &tela->lote_fichas,
+                                                   layout.tabuleiro.x, layout.tabuleiro.y);
+        SDL_SetRenderTarget(renderer, NULL);
+        memcpy(tela->tabuleiro_na_camada, tabuleiro_virtual, sizeof(tabuleiro_virtual));
+        tela->camada_valida = true;
+    }
+
+    // Define cor de fundo conforme modo de jogo
+    if (estado_atual == JOGO_PVP) SDL_SetRenderDrawColor(renderer, 200, 255, 200, 255);
+    if (estado_atual == JOGO_IA)  SDL_SetRenderDrawColor(renderer, 255, 230, 200, 255);
+
+    SDL_RenderClear(renderer);
+    chamadas++;
+
+    // Desenha peças em animação (caindo), entre o passo anterior e o atual da simulação, em um lote
+    lote_limpar(&tela->lote_fichas);
+    for (int i = 0; i < MAX_ANIMACOES; i++) {
+        if (animacoes[i].ativa) {
+            float y = animacoes[i].y_anterior + (animacoes[i].y_atual - animacoes[i].y_anterior) * interpolacao;
+
+            // Seleciona o sprite da ficha conforme jogador
+            int sprite = (animacoes[i].jogador == 1) ? SPRITE_FICHA_VERMELHA : SPRITE_FICHA_AMARELA;
+            SDL_FRect destino = {
+                layout.casas[0][animacoes[i].coluna].x,
+                y,
+                (float)(raio_ficha * 2),
+                (float)(raio_ficha * 2)
+            };
+            lote_adicionar(&tela->lote_fichas, &tela->atlas, sprite, &destino);
+        }
+    }
+    chamadas += lote_desenhar(renderer, &tela->lote_fichas, &tela->atlas);
+
+    // Peças paradas e tabuleiro por cima das que estão caindo: uma cópia só da camada
+    if (tela->camada_tabuleiro) {
+        SDL_RenderCopy(renderer, tela->camada_tabuleiro, NULL, &layout.tabuleiro);
+        chamadas++;
+    } else {
+        chamadas += desenhar_pecas_e_tabuleiro(renderer, tela->tabuleiro, &tela->atlas, &tela->lote_fichas, 0, 0);
+    }
+
+    // Se for a tela final, mostra a imagem do vencedor
+    if (estado_atual == FINAL) {
+        SDL_RenderCopy(renderer, (jogador_vencedor == 1 ? tela->vencedor1 : tela->vencedor2), NULL, NULL);
+        chamadas++;
     }
+    return chamadas;
+}
+
+/*
+    Partida do modo sem janela: o vermelho completa a linha de baixo em
+    quatro colunas seguidas, a partir de COLUNA_ROTEIRO (2 a 5 no 7x6;
+    perto do meio, mas sem passar da última coluna nos tabuleiros menores).
+*/
+#define COLUNA_ROTEIRO (COLUNAS / 2 - 1 < COLUNAS - 4 ? COLUNAS / 2 - 1 : COLUNAS - 4)
+_Static_assert(COLUNA_ROTEIRO >= 0 && COLUNA_ROTEIRO + 3 < COLUNAS && LINHAS >= 2,
+               "O roteiro do modo sem janela deve caber no tabuleiro");
+const int roteiro_sem_janela[] = {COLUNA_ROTEIRO + 1, COLUNA_ROTEIRO + 1, COLUNA_ROTEIRO + 2, COLUNA_ROTEIRO + 2,
+                                  COLUNA_ROTEIRO, COLUNA_ROTEIRO, COLUNA_ROTEIRO + 3};
+
+/*
+    Modo sem janela (--sem-janela): desenha `num_quadros` quadros do jogo
+    com o renderizador por software em uma SDL_Surface, com o driver de vídeo
+    "dummy" (sem janela nem GPU), para testes de regressão e medição de
+    desempenho em máquinas sem tela. O roteiro é determinístico: menu, a
+    partida de roteiro_sem_janela com a queda simulada a 60 quadros por
+    segundo e a tela de vitória, repetidos até completar os quadros.
+
+    Cada quadro tem CRC32 e MD5 (SDL_test) dos pixels. Com `referencia`,
+    as somas são comparadas com as do arquivo (uma linha por quadro); se ele
+    ainda não existir, é gravado. Retorna 0 se todos os quadros conferem.
+*/
+int executar_sem_janela(int num_quadros, const char* referencia) {
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        printf("Nao foi possivel iniciar a SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG);
+    int largura = LARGURA_LOGICA, altura = ALTURA_LOGICA; // Tamanho original da janela do jogo (escala 1)
+    SDL_Surface* superficie = SDL_CreateRGBSurfaceWithFormat(0, largura, altura, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = superficie ? SDL_CreateSoftwareRenderer(superficie) : NULL;
+    if (renderer) {
+        SDL_RenderSetLogicalSize(renderer, LARGURA_LOGICA, ALTURA_LOGICA);
+        calcular_layout(renderer);
+    }
+    RecursosTela tela = {0};
+    if (!renderer || !carregar_recursos(&tela, renderer)) {
+        printf("Nao foi possivel preparar o desenho sem janela: %s\n", SDL_GetError());
+        liberar_recursos(&tela);
+        if (renderer) SDL_DestroyRenderer(renderer);
+        if (superficie) SDL_FreeSurface(superficie);
+        IMG_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    // Referência: lida se o arquivo existir, gravada se não
+    FILE* arquivo_referencia = referencia ? fopen(referencia, "r") : NULL;
+    FILE* gravacao = referencia && !arquivo_referencia ? fopen(referencia, "w") : NULL;
+
+    estado_atual = MENU;
+    jogador_vencedor = 0;
+    memset(animacoes, 0, sizeof(animacoes));
+    memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
+    int jogador_atual = 1, jogada = 0, quadros_final = 0, divergencias = 0;
+    const int num_jogadas = (int)(sizeof(roteiro_sem_janela) / sizeof(roteiro_sem_janela[0]));
+
+    SDLTest_Md5Context md5_total;
+    SDLTest_Md5Init(&md5_total);
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    Uint64 tempo_desenho = 0, tempo_somas = 0;
+
+    for (int quadro = 0; quadro < num_quadros; quadro++) {
+        // Roteiro: um quadro de menu, a partida e QUADROS_TELA_FINAL quadros de vitória
+        if (estado_atual == MENU && quadro > 0) {
+            estado_atual = JOGO_PVP;
+            jogador_atual = 1;
+            jogada = 0;
+            memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
+        } else if (estado_atual == FINAL && ++quadros_final > QUADROS_TELA_FINAL) {
+            estado_atual = MENU;
+            jogador_vencedor = 0;
+            quadros_final = 0;
+        } else if (estado_atual == JOGO_PVP) {
+            if (!animacao_em_andamento()) {
+                if (jogada < num_jogadas) {
+                    int coluna = roteiro_sem_janela[jogada++];
+                    iniciar_animacao(coluna, encontrar_linha_disponivel(coluna), jogador_atual);
+                } else {
+                    estado_atual = MENU; // Roteiro sem vitória: recomeça
+                }
+            }
+            // Dois passos de 1/120 s por quadro, como o jogo a 60 quadros por segundo
+            for (int passo = 0; passo < 2 && animacao_em_andamento(); passo++) simular_passo_animacoes(&jogador_atual);
+        }
+
+        Uint64 antes = SDL_GetPerformanceCounter();
+        desenhar_tela(renderer, &tela, 0.5f);
+        SDL_RenderPresent(renderer); // Descarrega os comandos pendentes na superfície
+        Uint64 depois = SDL_GetPerformanceCounter();
+        tempo_desenho += depois - antes;
+
+        // Somas de verificação dos pixels, linha por linha (o pitch pode ter sobra)
+        SDLTest_Crc32Context contexto_crc;
+        SDLTest_Md5Context md5;
+        CrcUint32 crc;
+        SDLTest_Crc32Init(&contexto_crc);
+        SDLTest_Crc32CalcStart(&contexto_crc, &crc);
+        SDLTest_Md5Init(&md5);
+        if (SDL_MUSTLOCK(superficie)) SDL_LockSurface(superficie);
+        for (int y = 0; y < altura; y++) {
+            unsigned char* linha = (unsigned char*)superficie->pixels + (size_t)y * (size_t)superficie->pitch;
+            unsigned int bytes = (unsigned int)largura * 4;
+            SDLTest_Crc32CalcBuffer(&contexto_crc, linha, bytes, &crc);
+            SDLTest_Md5Update(&md5, linha, bytes);
+            SDLTest_Md5Update(&md5_total, linha, bytes);
+        }
+        if (SDL_MUSTLOCK(superficie)) SDL_UnlockSurface(superficie);
+        SDLTest_Crc32CalcEnd(&contexto_crc, &crc);
+        SDLTest_Crc32Done(&contexto_crc);
+        SDLTest_Md5Final(&md5);
+        tempo_somas += SDL_GetPerformanceCounter() - depois;
+
+        char soma[64], esperada[64];
+        int n = snprintf(soma, sizeof(soma), "%05d %08x ", quadro, (unsigned)crc);
+        for (int i = 0; i < 16; i++) n += snprintf(soma + n, sizeof(soma) - (size_t)n, "%02x", md5.digest[i]);
+        if (gravacao) fprintf(gravacao, "%s\n", soma);
+        if (arquivo_referencia) {
+            bool igual = fgets(esperada, sizeof(esperada), arquivo_referencia) != NULL;
+            esperada[strcspn(esperada, "\r\n")] = '\0';
+            if (!igual || strcmp(soma, esperada) != 0) {
+                if (divergencias < 5) printf("Quadro %d difere da referencia: %s (esperado %s)\n", quadro, soma,
+                                             igual ? esperada : "nada");
+                divergencias++;
+            }
+        }
+    }
+    SDLTest_Md5Final(&md5_total);
+
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(renderer, &info);
+    double segundos_desenho = (double)tempo_desenho / frequencia;
+    printf("Renderizador %s, %d quadros de %dx%d sem janela\n", info.name, num_quadros, largura, altura);
+    printf("  desenho: %.1f quadros/s (%.3f ms por quadro)\n", segundos_desenho > 0 ? num_quadros / segundos_desenho : 0.0,
+           num_quadros ? segundos_desenho * 1000.0 / num_quadros : 0.0);
+    printf("  somas de verificacao: %.3f ms por quadro\n",
+           num_quadros ? (double)tempo_somas / frequencia * 1000.0 / num_quadros : 0.0);
+    printf("  MD5 de todos os quadros: ");
+    for (int i = 0; i < 16; i++) printf("%02x", md5_total.digest[i]);
+    printf("\n");
+    if (gravacao) printf("Referencia gravada em %s\n", referencia);
+    if (arquivo_referencia) {
+        if (divergencias) printf("%d quadros diferentes da referencia %s\n", divergencias, referencia);
+        else printf("Todos os quadros conferem com a referencia %s\n", referencia);
+    }
+
+    if (gravacao) fclose(gravacao);
+    if (arquivo_referencia) fclose(arquivo_referencia);
+    liberar_recursos(&tela);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(superficie);
+    IMG_Quit();
+    SDL_Quit();
+    return divergencias ? 1 : 0;
+}
+
+/*
+    Eventos da janela que pedem um novo quadro: o conteúdo mostrado pode ter
+    se perdido (exposição, janela reaparecendo) ou a escala mudou. Foco,
+    movimento e entrada ou saída do mouse não mudam nada na tela.
+*/
+bool janela_precisa_redesenho(const SDL_Event* evento) {
+    if (evento->type != SDL_WINDOWEVENT) return false;
+    switch (evento->window.event) {
+        case SDL_WINDOWEVENT_SHOWN:
+        case SDL_WINDOWEVENT_EXPOSED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+        case SDL_WINDOWEVENT_RESTORED:
+        case SDL_WINDOWEVENT_MAXIMIZED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Lugar de uma partida na grade do modo espectador, em coordenadas lógicas
+typedef struct {
+    SDL_Rect celula;   // Fundo da partida, pintado na cor do resultado
+    float x, y;        // Canto da imagem do tabuleiro
+    float escala;      // Tamanho do tabuleiro em relação ao do jogo normal
+} VistaPartida;
+
+// Fundo de cada partida conforme o resultado
+const SDL_Color cores_resultado[NUM_RESULTADOS] = {
+    {255, 230, 200, 255}, // Em andamento (o fundo do jogo contra a IA)
+    {255, 180, 180, 255}, // Vitória do vermelho
+    {255, 240, 150, 255}, // Vitória do amarelo
+    {210, 210, 210, 255}, // Empate
+};
+
+/*
+    Monta a grade do modo espectador: escolhe o número de colunas que deixa
+    os tabuleiros maiores e centra cada tabuleiro na sua célula.
+*/
+void calcular_grade(VistaPartida* vistas, int num_partidas) {
+    int melhor_colunas = 1;
+    float melhor_escala = 0;
+    for (int c = 1; c <= num_partidas; c++) {
+        int l = (num_partidas + c - 1) / c;
+        float escala = SDL_min(((float)LARGURA_LOGICA / c - 2 * MARGEM_TORNEIO) / layout.tabuleiro.w,
+                               ((float)ALTURA_LOGICA / l - 2 * MARGEM_TORNEIO) / layout.tabuleiro.h);
+        if (escala > melhor_escala) {
+            melhor_escala = escala;
+            melhor_colunas = c;
+        }
+    }
+    int linhas = (num_partidas + melhor_colunas - 1) / melhor_colunas;
+    int largura = LARGURA_LOGICA / melhor_colunas, altura = ALTURA_LOGICA / linhas;
+    for (int i = 0; i < num_partidas; i++) {
+        VistaPartida* v = &vistas[i];
+        v->celula = (SDL_Rect){(i % melhor_colunas) * largura + 1, (i / melhor_colunas) * altura + 1, largura - 2, altura - 2};
+        v->escala = melhor_escala;
+        v->x = (float)v->celula.x + ((float)v->celula.w - layout.tabuleiro.w * melhor_escala) / 2;
+        v->y = (float)v->celula.y + ((float)v->celula.h - layout.tabuleiro.h * melhor_escala) / 2;
+    }
+}
+
+/*
+    Desenha as partidas marcadas em `mudou`: o fundo da célula na cor do
+    resultado (uma chamada por cor), depois as fichas e os tabuleiros de
+    todas elas em um único lote do atlas, fichas antes, tabuleiros por cima.
+    Retorna quantas chamadas de desenho foram feitas.
+*/
+int desenhar_partidas(SDL_Renderer* renderer, const AtlasSprites* atlas, LoteSprites* lote, const VistaPartida* vistas,
+                      int (*casas)[LINHAS][COLUNAS], const ResultadoPartida* resultados, const bool* mudou,
+                      int num_partidas) {
+    int chamadas = 0;
+    SDL_Rect fundos[TORNEIO_MAX_PARTIDAS];
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    for (int r = 0; r < NUM_RESULTADOS; r++) {
+        int n = 0;
+        for (int i = 0; i < num_partidas; i++)
+            if (mudou[i] && resultados[i] == (ResultadoPartida)r) fundos[n++] = vistas[i].celula;
+        if (n == 0) continue;
+        SDL_SetRenderDrawColor(renderer, cores_resultado[r].r, cores_resultado[r].g, cores_resultado[r].b, 255);
+        SDL_RenderFillRects(renderer, fundos, n);
+        chamadas++;
+    }
+
+    lote_limpar(lote);
+    for (int i = 0; i < num_partidas; i++) {
+        if (!mudou[i]) continue;
+        const VistaPartida* v = &vistas[i];
+        for (int l = 0; l < LINHAS; l++) {
+            for (int c = 0; c < COLUNAS; c++) {
+                if (casas[i][l][c] == 0) continue;
+                int sprite = casas[i][l][c] == 1 ? SPRITE_FICHA_VERMELHA : SPRITE_FICHA_AMARELA;
+                SDL_FRect destino = {
+                    v->x + (layout.casas[l][c].x - layout.tabuleiro.x) * v->escala,
+                    v->y + (layout.casas[l][c].y - layout.tabuleiro.y) * v->escala,
+                    layout.casas[l][c].w * v->escala,
+                    layout.casas[l][c].h * v->escala
+                };
+                lote_adicionar(lote, atlas, sprite, &destino);
+            }
+        }
+    }
+    for (int i = 0; i < num_partidas; i++) {
+        if (!mudou[i]) continue;
+        for (int p = 0; p < layout.num_pedacos; p++) {
+            const SDL_Rect* pedaco = &layout.pedacos[p];
+            SDL_FRect destino = {vistas[i].x + (float)pedaco->x * vistas[i].escala,
+                                 vistas[i].y + (float)pedaco->y * vistas[i].escala,
+                                 (float)pedaco->w * vistas[i].escala, (float)pedaco->h * vistas[i].escala};
+            lote_adicionar_parte(lote, atlas, SPRITE_TABULEIRO, &layout.recortes[p], &destino);
+        }
+    }
+    return chamadas + lote_desenhar(renderer, lote, atlas);
+}
+
+// Textura com a grade inteira no tamanho real em pixels da área lógica (NULL sem suporte a texturas alvo)
+SDL_Texture* criar_quadro_torneio(SDL_Renderer* renderer) {
+    SDL_Texture* quadro = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                            (int)SDL_ceilf(LARGURA_LOGICA * layout.escala),
+                                            (int)SDL_ceilf(ALTURA_LOGICA * layout.escala));
+    if (quadro) SDL_SetTextureBlendMode(quadro, SDL_BLENDMODE_NONE); // Opaca: fundo e células cobrem tudo
+    return quadro;
+}
+
+/*
+    Modo espectador (--torneio): `num_partidas` partidas IA contra IA correndo
+    ao mesmo tempo (ver torneio.h), mostradas em uma grade em uma janela.
+    A grade fica guardada em uma textura alvo e só as partidas que mudaram
+    desde o último quadro são redesenhadas nela, em poucas chamadas (ver
+    desenhar_partidas); o laço dorme até uma partida mudar ou a janela
+    pedir um quadro novo. O placar vai no título da janela.
+*/
+int executar_torneio(int num_partidas, double ms_por_jogada) {
+    if (num_partidas < 1) num_partidas = 1;
+    if (num_partidas > TORNEIO_MAX_PARTIDAS) num_partidas = TORNEIO_MAX_PARTIDAS;
+    SDL_Init(SDL_INIT_VIDEO);
+    IMG_Init(IMG_INIT_PNG);
+    Uint32 evento_partidas = SDL_RegisterEvents(1);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear"); // Tabuleiros reduzidos
+    SDL_Window* janela = SDL_CreateWindow("Connect Four - torneio", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                          LARGURA_LOGICA, ALTURA_LOGICA,
+                                          SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+    SDL_Renderer* renderer = janela ? SDL_CreateRenderer(janela, -1, SDL_RENDERER_PRESENTVSYNC) : NULL;
+    if (renderer) {
+        SDL_RenderSetLogicalSize(renderer, LARGURA_LOGICA, ALTURA_LOGICA);
+        calcular_layout(renderer);
+    }
+
+    AtlasSprites atlas = {0};
+    LoteSprites lote = {0};
+    VistaPartida* vistas = malloc((size_t)num_partidas * sizeof(VistaPartida));
+    int (*casas)[LINHAS][COLUNAS] = malloc((size_t)num_partidas * sizeof(*casas));
+    ResultadoPartida* resultados = malloc((size_t)num_partidas * sizeof(ResultadoPartida));
+    int* versoes = malloc((size_t)num_partidas * sizeof(int));
+    bool* mudou = malloc((size_t)num_partidas * sizeof(bool));
+    Torneio torneio;
+    bool ok = renderer && vistas && casas && resultados && versoes && mudou && atlas_criar(&atlas, renderer) &&
+              lote_criar(&lote, num_partidas * (TOTAL_CASAS + MAX_PEDACOS)) &&
+              torneio_iniciar(&torneio, num_partidas, ms_por_jogada, evento_partidas);
+    if (!ok) printf("Nao foi possivel iniciar o modo espectador: %s\n", SDL_GetError());
+
+    SDL_Texture* quadro = ok ? criar_quadro_torneio(renderer) : NULL;
+    if (ok) calcular_grade(vistas, num_partidas);
+    bool rodando = ok, redesenhar_todas = true, apresentar = true;
+    int placar_anterior = -1;
+    while (rodando) {
+        SDL_Event evento;
+        if (SDL_WaitEvent(&evento)) do {
+            if (evento.type == SDL_QUIT) rodando = false;
+            if (evento.type == SDL_WINDOWEVENT && evento.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                calcular_layout(renderer);
+                if (quadro) SDL_DestroyTexture(quadro);
+                quadro = criar_quadro_torneio(renderer);
+                redesenhar_todas = true;
+            }
+            if (evento.type == SDL_RENDER_TARGETS_RESET || evento.type == SDL_RENDER_DEVICE_RESET) redesenhar_todas = true;
+            if (janela_precisa_redesenho(&evento)) apresentar = true;
+        } while (SDL_PollEvent(&evento));
+
+        // Copia as partidas que mudaram; sem a textura da grade, todas são redesenhadas a cada quadro
+        torneio_ler_aviso(&torneio);
+        int mudancas = 0;
+        for (int i = 0; i < num_partidas; i++) {
+            if (redesenhar_todas || !quadro) versoes[i] = -1;
+            mudou[i] = torneio_copiar_partida(&torneio, i, &versoes[i], casas[i], &resultados[i]);
+            if (mudou[i]) mudancas++;
+        }
+        if (mudancas == 0 && !apresentar) continue;
+        apresentar = false;
+
+        if (quadro) {
+            SDL_SetRenderTarget(renderer, quadro);
+            SDL_RenderSetScale(renderer, layout.escala, layout.escala);
+            if (redesenhar_todas) {
+                SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255); // Linhas entre as células
+                SDL_RenderClear(renderer);
+            }
+            desenhar_partidas(renderer, &atlas, &lote, vistas, casas, resultados, mudou, num_partidas);
+            SDL_SetRenderTarget(renderer, NULL);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, quadro, NULL, NULL);
+        } else {
+            SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
+            SDL_RenderClear(renderer);
+            desenhar_partidas(renderer, &atlas, &lote, vistas, casas, resultados, mudou, num_partidas);
+        }
+        redesenhar_todas = false;
+        SDL_RenderPresent(renderer);
+
+        // Placar no título, quando muda
+        int vermelho = SDL_AtomicGet(&torneio.placar[PARTIDA_VERMELHO]);
+        int amarelo = SDL_AtomicGet(&torneio.placar[PARTIDA_AMARELO]);
+        int empates = SDL_AtomicGet(&torneio.placar[PARTIDA_EMPATE]);
+        if (vermelho + amarelo + empates != placar_anterior) {
+            char titulo[128];
+            snprintf(titulo, sizeof(titulo), "Connect Four - %d partidas: vermelho %d, amarelo %d, empates %d",
+                     num_partidas, vermelho, amarelo, empates);
+            SDL_SetWindowTitle(janela, titulo);
+            placar_anterior = vermelho + amarelo + empates;
+        }
+    }
+
+    if (ok) torneio_encerrar(&torneio);
+    if (quadro) SDL_DestroyTexture(quadro);
+    lote_destruir(&lote);
+    atlas_destruir(&atlas);
+    free(vistas);
+    free(casas);
+    free(resultados);
+    free(versoes);
+    free(mudou);
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (janela) SDL_DestroyWindow(janela);
+    IMG_Quit();
+    SDL_Quit();
+    return ok ? 0 : 1;
 }
 
 /*
@@ -174,55 +1029,207 @@ void tratar_clique(int mouse_x, int mouse_y, int* jogador_atual) {
 int main(int argc, char** argv) {
     bool ignorar_primeiro_clique = false; // Flag para ignorar clique acidental após mudança de tela
     srand((unsigned int)time(NULL));      // Inicializa a semente do gerador de números aleatórios
+    motor_inicializar();                  // Prepara as tabelas da IA
+    tt_criar(&tabela_ia, TAMANHO_TT_MB);
+
+    // Modos de benchmark: medem partes da IA e saem sem abrir janela
+    if (argc > 1 && strcmp(argv[1], "--bench-avaliacao") == 0) {
+        benchmark_avaliacao(100000, 50);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-playouts") == 0) {
+        benchmark_playouts(2000000);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-aspiracao") == 0) {
+        benchmark_aspiracao(argc > 2 ? atoi(argv[2]) : PROFUNDIDADE_IA, &tabela_ia);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-prazo") == 0) {
+        benchmark_prazo(argc > 2 ? atof(argv[2]) : TEMPO_IA_MS, &tabela_ia);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-tt") == 0) {
+        benchmark_tt();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-reducoes") == 0) {
+        // Terceiro argumento: "lmr" (só reduções), "ext" (só extensões) ou nada (as duas)
+        const char* modo = argc > 4 ? argv[4] : "";
+        benchmark_reducoes(argc > 2 ? atoi(argv[2]) : 200, argc > 3 ? atof(argv[3]) : 20,
+                           strcmp(modo, "ext") != 0, strcmp(modo, "lmr") != 0);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-prova") == 0) {
+        TabelaProva tabela_prova;
+        if (prova_criar(&tabela_prova, TAMANHO_PROVA_MB)) {
+            benchmark_prova(&tabela_prova, &tabela_ia, argc > 2 ? atof(argv[2]) : 10000);
+            prova_destruir(&tabela_prova);
+        }
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-sprites") == 0) {
+        benchmark_sprites(argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atof(argv[3]) : 5.0);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-quadros") == 0) {
+        // Modo: "vsync" (padrão), "livre" ou quadros por segundo
+        ModoRitmo modo = RITMO_VSYNC;
+        double quadros_por_segundo = 0;
+        if (argc > 2 && !ritmo_interpretar(argv[2], &modo, &quadros_por_segundo)) {
+            printf("Modo de quadros desconhecido: %s (use vsync, livre ou quadros por segundo)\n", argv[2]);
+            return 1;
+        }
+        benchmark_ritmo(modo, quadros_por_segundo, argc > 3 ? atof(argv[3]) : 5.0);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--torneio") == 0) {
+        return executar_torneio(argc > 2 ? atoi(argv[2]) : PARTIDAS_TORNEIO, argc > 3 ? atof(argv[3]) : MS_JOGADA_TORNEIO);
+    }
+    if (argc > 1 && strcmp(argv[1], "--sem-janela") == 0) {
+        return executar_sem_janela(argc > 2 ? atoi(argv[2]) : QUADROS_SEM_JANELA, argc > 3 ? argv[3] : NULL);
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-mcts") == 0) {
+        benchmark_mcts(argc > 2 ? atoi(argv[2]) : 5000);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench-rede") == 0) {
+        // Usa os pesos do arquivo indicado (ou de ARQUIVO_REDE); sem arquivo, pesos aleatórios
+        if (!rede_carregar(&rede_ia, argc > 2 ? argv[2] : ARQUIVO_REDE)) rede_aleatoria(&rede_ia, 42);
+        benchmark_rede(&rede_ia, 100000, 50);
+        return 0;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "--gerar-solucao") == 0) {
+        // Só para tabuleiros pequenos (compilar com -DLINHAS=... -DCOLUNAS=...)
+        char padrao[64];
+        snprintf(padrao, sizeof(padrao), FORMATO_ARQUIVO_SOLUCAO, COLUNAS, LINHAS);
+        return solucao_gerar(argc > 2 ? argv[2] : padrao, argc > 3 ? atoi(argv[3]) : 0) ? 0 : 1;
+    }
+
+    // Banco de solução do tabuleiro compilado, se já foi gerado
+    char arquivo_solucao[64];
+    snprintf(arquivo_solucao, sizeof(arquivo_solucao), FORMATO_ARQUIVO_SOLUCAO, COLUNAS, LINHAS);
+    if (solucao_abrir(&solucao_ia, arquivo_solucao))
+        SDL_Log("IA: banco de solucao %s (%llu posicoes)", arquivo_solucao,
+                (unsigned long long)solucao_ia.num_posicoes);
+
+    // --cache [arquivo]: guarda as posições resolvidas em disco entre execuções
+    if (argc > 1 && strcmp(argv[1], "--cache") == 0) {
+        const char* arquivo_cache = argc > 2 && strncmp(argv[2], "--", 2) != 0 ? argv[2] : ARQUIVO_CACHE;
+        if (cache_abrir(&cache_ia, arquivo_cache, TAMANHO_CACHE_MB))
+            SDL_Log("IA: cache em disco %s (%llu entradas)", arquivo_cache, (unsigned long long)cache_ia.num_entradas);
+    }
+
+    if (rede_carregar(&rede_ia, ARQUIVO_REDE)) {
+        motor_usar_rede(&rede_ia);
+        SDL_Log("IA: usando a rede neural de %s (nucleo %s)", ARQUIVO_REDE, rede_nucleo());
+    }
+
+    // --quadros vsync|livre|N (em qualquer posição): ritmo dos quadros durante as animações; padrão VSync
+    ModoRitmo modo_ritmo = RITMO_VSYNC;
+    double quadros_por_segundo = 0;
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], "--quadros") == 0 && !ritmo_interpretar(argv[i + 1], &modo_ritmo, &quadros_por_segundo))
+            SDL_Log("Ritmo: modo %s desconhecido (use vsync, livre ou quadros por segundo)", argv[i + 1]);
 
     // Inicialização da SDL e SDL_image
     SDL_Init(SDL_INIT_EVERYTHING);
     IMG_Init(IMG_INIT_PNG);
+    evento_ia_pronta = SDL_RegisterEvents(1);
 
-    // Criação da janela e do renderizador
-    int largura_janela = 900;
-    int altura_janela = 614;
-    SDL_Window* window = SDL_CreateWindow("Connect Four", 100, 100, largura_janela, altura_janela, SDL_WINDOW_SHOWN);
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, 0);
+    // Criação da janela e do renderizador: no tamanho original, reduzida se não couber na tela, e redimensionável
+    int largura_janela = LARGURA_LOGICA;
+    int altura_janela = ALTURA_LOGICA;
+    SDL_Rect area_util;
+    if (SDL_GetDisplayUsableBounds(0, &area_util) == 0 && (area_util.w < largura_janela || area_util.h < altura_janela)) {
+        float reducao = SDL_min((float)area_util.w / LARGURA_LOGICA, (float)area_util.h / ALTURA_LOGICA);
+        largura_janela = (int)(LARGURA_LOGICA * reducao);
+        altura_janela = (int)(ALTURA_LOGICA * reducao);
+    }
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear"); // Imagens suaves fora da escala 1
+    SDL_Window* window = SDL_CreateWindow("Connect Four", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, largura_janela,
+                                          altura_janela, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+    static RitmoQuadros ritmo; // Estático: guarda alguns milhares de intervalos medidos
+    ritmo_iniciar(&ritmo, modo_ritmo, quadros_por_segundo);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, ritmo_flags_renderizador(&ritmo));
+    ritmo_configurar(&ritmo, window, renderer);
+    SDL_RenderSetLogicalSize(renderer, LARGURA_LOGICA, ALTURA_LOGICA);
+    calcular_layout(renderer);
+    PainelDesempenho painel;
+    painel_criar(&painel, renderer);
 
     // Carregamento de imagens/texturas
-    SDL_Texture* menu_img = IMG_LoadTexture(renderer, "imagens/menu.png");
-    SDL_Texture* tabuleiro = IMG_LoadTexture(renderer, "imagens1/jogo_tabuleiro.png");
-    SDL_Texture* ficha_vermelha = IMG_LoadTexture(renderer, "imagens1/ficha_vermelha.png");
-    SDL_Texture* ficha_amarela = IMG_LoadTexture(renderer, "imagens1/ficha_amarela.png");
-    SDL_Texture* vencedor1 = IMG_LoadTexture(renderer, "imagens/vencedor1.png");
-    SDL_Texture* vencedor2 = IMG_LoadTexture(renderer, "imagens/vencedor2.png");
+    RecursosTela tela;
+    carregar_recursos(&tela, renderer);
 
     int jogador_atual = 1;   // Indica de quem é a vez (1 = vermelho, 2 = amarelo)
     SDL_Event event;
     bool running = true;     // Controla se o jogo está rodando
+    bool redesenhar = true;  // A tela mudou desde o último quadro desenhado
+    EstadoJogo estado_desenhado = estado_atual; // Tela do último quadro desenhado
+    Uint32 inicio_pausa_ia = 0;   // Início da pausa antes da jogada da IA (0 = fora da pausa)
 
-    // Loop principal do jogo
+    /*
+        Loop principal do jogo, guiado por eventos: sem animação nem pausa da
+        IA pendentes, fica bloqueado em SDL_WaitEventTimeout até chegar uma
+        entrada ou o aviso de que a IA terminou, sem gastar CPU.
+    */
     while (running) {
-        // Loop de eventos SDL
-        while (SDL_PollEvent(&event)) {
+        // Quanto dá para dormir: até o prazo do próximo quadro da animação, até o fim da pausa da IA ou sem limite (-1)
+        int espera = -1;
+        Uint32 agora = SDL_GetTicks();
+        if (redesenhar) {
+            espera = 0;
+        } else if (animacao_em_andamento()) {
+            espera = ritmo_espera_ms(&ritmo);
+        } else if (inicio_pausa_ia && !thread_ia) {
+            Uint32 fim_pausa = inicio_pausa_ia + PAUSA_IA_MS + 1;
+            espera = SDL_TICKS_PASSED(agora, fim_pausa) ? 0 : (int)(fim_pausa - agora);
+        }
+        if (thread_ia && painel.visivel && (espera < 0 || espera > PAINEL_ATUALIZACAO_MS)) espera = PAINEL_ATUALIZACAO_MS;
+
+        // Eventos SDL: o primeiro é esperado, os que chegaram junto são tratados em seguida
+        if (SDL_WaitEventTimeout(&event, espera)) do {
             if (event.type == SDL_QUIT) running = false;
+            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3 && !event.key.repeat) {
+                painel_alternar(&painel);
+                redesenhar = true;
+            }
+            // A janela perdeu o conteúdo ou mudou de escala: apresenta a mesma tela de novo
+            if (janela_precisa_redesenho(&event)) redesenhar = true;
+            // Nova escala: refaz a tabela de layout e a camada do tabuleiro no novo tamanho em pixels
+            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                calcular_layout(renderer);
+                criar_camada(&tela, renderer);
+            }
+            // O conteúdo das texturas alvo se perde quando o dispositivo gráfico é reiniciado
+            if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                tela.camada_valida = false;
+                painel_invalidar(&painel);
+                redesenhar = true;
+            }
 
             // Lógica da tela de menu
             if (estado_atual == MENU && event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
-                int x = event.button.x;
-                int y = event.button.y;
+                // Coordenadas já convertidas para as lógicas pela SDL (SDL_RenderSetLogicalSize)
+                int acao = botao_clicado(botoes_menu, NUM_BOTOES(botoes_menu), event.button.x, event.button.y);
                 // Botão para jogar contra IA
-                if (x >= 299 && x <= 585 && y >= 282 && y <= 335) {
+                if (acao == BOTAO_JOGAR_IA) {
                     estado_atual = JOGO_IA;
                     ignorar_primeiro_clique = true;
                     jogador_atual = 1;
                     jogador_vencedor = 0;
                     memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
                 // Botão para jogar PvP
-                } else if (x >= 301 && x <= 585 && y >= 403 && y <= 449) {
+                } else if (acao == BOTAO_JOGAR_PVP) {
                     estado_atual = JOGO_PVP;
                     ignorar_primeiro_clique = true;
                     jogador_atual = 1;
                     jogador_vencedor = 0;
                     memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
                 // Botão para sair
-                } else if (x >= 294 && x <= 585 && y >= 516 && y <= 566) {
+                } else if (acao == BOTAO_SAIR) {
                     running = false;
                 }
             }
@@ -235,6 +1242,7 @@ int main(int argc, char** argv) {
                     ignorar_primeiro_clique = false;
                     continue; // Ignora primeiro clique após mudança de tela
                 }
+                if (thread_ia) continue; // O tabuleiro não muda enquanto a IA pensa
 
                 int mouse_x = event.button.x;
                 int mouse_y = event.button.y;
@@ -243,148 +1251,114 @@ int main(int argc, char** argv) {
 
             // Lógica da tela final (após vitória): trata botões de "Menu" e "Sair"
             if (estado_atual == FINAL && event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
-                int x = event.button.x;
-                int y = event.button.y;
+                int acao = botao_clicado(botoes_final, NUM_BOTOES(botoes_final), event.button.x, event.button.y);
                 // Botão para voltar ao menu
-                if (x >= 276 && x <= 600 && y >= 368 && y <= 420) {
+                if (acao == BOTAO_MENU) {
                     estado_atual = MENU;
                     jogador_atual = 1;
                     jogador_vencedor = 0;
                     memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
                 // Botão para sair
-                } else if (x >= 276 && x <= 600 && y >= 448 && y <= 506) {
+                } else if (acao == BOTAO_SAIR) {
                     running = false;
                 }
             }
-        }
+        } while (SDL_PollEvent(&event));
 
         // Movimento da IA (apenas no modo IA)
         if (estado_atual == JOGO_IA && jogador_atual == 2) {
             // Só joga se não há animação em andamento
-            bool animando = false;
-            for (int i = 0; i < MAX_ANIMACOES; i++) {
-                if (animacoes[i].ativa) {
-                    animando = true;
-                    break;
-                }
-            }
-
-            // Variável estática para controlar tempo de espera entre jogadas da IA
-            static Uint32 tempo_espera = 0;
-
-            if (!animando) {
+            if (!animacao_em_andamento()) {
                 // Começa a contar tempo se não estava antes
-                if (tempo_espera == 0) tempo_espera = SDL_GetTicks();
+                if (inicio_pausa_ia == 0) inicio_pausa_ia = SDL_GetTicks();
+
+                // Espera PAUSA_IA_MS antes da IA jogar (efeito visual) e então começa a pensar em outra thread
+                if (SDL_GetTicks() - inicio_pausa_ia > PAUSA_IA_MS && !thread_ia) {
+                    posicao_ia = posicao_de_tabuleiro(tabuleiro_virtual, 2);
+                    SDL_AtomicSet(&ia_terminou, 0);
+                    SDL_AtomicSet(&parada_ia, 0);
+                    inicio_busca_ia = SDL_GetTicks();
+                    thread_ia = SDL_CreateThread(pensar_ia, "IA", NULL);
+                    if (!thread_ia) pensar_ia(NULL); // Sem threads: pensa aqui mesmo
+                }
 
-                // Espera 500 ms antes da IA jogar (efeito visual)
-                if (SDL_GetTicks() - tempo_espera > 500) {
-                    int coluna_ia = escolher_coluna_ia();
-                    int linha_disp = encontrar_linha_disponivel(coluna_ia);
+                // Jogada pronta: anima a peça
+                if (SDL_AtomicGet(&ia_terminou)) {
+                    if (thread_ia) SDL_WaitThread(thread_ia, NULL);
+                    thread_ia = NULL;
+                    SDL_AtomicSet(&ia_terminou, 0);
+                    int linha_disp = coluna_ia_calculada >= 0 ? encontrar_linha_disponivel(coluna_ia_calculada) : -1;
                     if (linha_disp != -1) {
-                        iniciar_animacao(coluna_ia, linha_disp, 2);
+                        iniciar_animacao(coluna_ia_calculada, linha_disp, 2);
                     }
-                    tempo_espera = 0;
+                    inicio_pausa_ia = 0;
+                    redesenhar = true;
                 }
             } else {
-                tempo_espera = 0;
+                inicio_pausa_ia = 0;
             }
+        } else {
+            inicio_pausa_ia = 0;
         }
 
-        // Renderiza a tela
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderClear(renderer);
-
-        // Tela de menu
-        if (estado_atual == MENU) {
-            SDL_RenderCopy(renderer, menu_img, NULL, NULL);
-            SDL_RenderPresent(renderer);
-            SDL_Delay(16);
-            continue;
-        }
-
-        // Define cor de fundo conforme modo de jogo
-        if (estado_atual == JOGO_PVP) SDL_SetRenderDrawColor(renderer, 200, 255, 200, 255);
-        if (estado_atual == JOGO_IA)  SDL_SetRenderDrawColor(renderer, 255, 230, 200, 255);
-
-        SDL_RenderClear(renderer);
-
-        // Desenha peças em animação (caindo)
-        for (int i = 0; i < MAX_ANIMACOES; i++) {
-            if (animacoes[i].ativa) {
-                float destinoY = centros_y[animacoes[i].linha_final] - raio_ficha;
-                // Move a peça verticalmente até o destino
-                if (animacoes[i].y_atual < destinoY) {
-                    animacoes[i].y_atual += 10;
-                    if (animacoes[i].y_atual > destinoY) animacoes[i].y_atual = destinoY;
-                } else {
-                    // Chegou ao destino: marca a peça no tabuleiro virtual e troca jogador
-                    animacoes[i].y_atual = destinoY;
-                    animacoes[i].ativa = false;
-                    tabuleiro_virtual[animacoes[i].linha_final][animacoes[i].coluna] = animacoes[i].jogador;
-
-                    // Checa vitória ou empate
-                    if (checar_vitoria(animacoes[i].jogador)) {
-                        estado_atual = FINAL;
-                        jogador_vencedor = animacoes[i].jogador;
-                    } else if (checar_empate()) {
-                        estado_atual = MENU;
-                        jogador_atual = 1;
-                        memset(tabuleiro_virtual, 0, sizeof(tabuleiro_virtual));
-                    } else {
-                        // Troca o jogador (1 <-> 2)
-                        jogador_atual = 3 - animacoes[i].jogador;
-                    }
-                }
-
-                // Seleciona textura da ficha conforme jogador
-                SDL_Texture* ficha = (animacoes[i].jogador == 1) ? ficha_vermelha : ficha_amarela;
-                SDL_Rect destino = {
-                    centros_x[animacoes[i].coluna] - raio_ficha,
-                    (int)animacoes[i].y_atual,
-                    raio_ficha * 2,
-                    raio_ficha * 2
-                };
-                SDL_RenderCopy(renderer, ficha, NULL, &destino);
+        /*
+            Peças caindo: a simulação anda em passos fixos conforme o tempo real
+            e o desenho interpola entre os dois últimos passos. A duração da
+            queda não depende da taxa de quadros; se desenhar atrasar, os passos
+            acumulados são simulados de uma vez e os quadros perdidos, pulados.
+        */
+        float interpolacao = 1.0f;
+        bool quadro_animado = animacao_em_andamento();
+        if (quadro_animado) {
+            // Modo limitado: completa a espera até o prazo do quadro girando; no VSync quem espera é o Present
+            ritmo_aguardar(&ritmo);
+            Uint64 contador = SDL_GetPerformanceCounter();
+            double decorrido = (double)(contador - relogio_animacao) / (double)SDL_GetPerformanceFrequency();
+            relogio_animacao = contador;
+            if (decorrido > ATRASO_MAXIMO_S) decorrido = ATRASO_MAXIMO_S;
+            acumulador_animacao += decorrido;
+            while (acumulador_animacao >= PASSO_ANIMACAO_S && animacao_em_andamento()) {
+                if (simular_passo_animacoes(&jogador_atual)) redesenhar = true; // A tela seguinte (peça parada, menu ou vitória) precisa ser desenhada
+                acumulador_animacao -= PASSO_ANIMACAO_S;
             }
+            interpolacao = (float)(acumulador_animacao / PASSO_ANIMACAO_S);
+            redesenhar = true;
         }
 
-        // Desenha todas as peças já posicionadas no tabuleiro
-        for (int i = 0; i < LINHAS; i++) {
-            for (int j = 0; j < COLUNAS; j++) {
-                if (tabuleiro_virtual[i][j] == 0) continue;
-                SDL_Texture* ficha = (tabuleiro_virtual[i][j] == 1) ? ficha_vermelha : ficha_amarela;
-                SDL_Rect destino = {
-                    centros_x[j] - raio_ficha,
-                    centros_y[i] - raio_ficha,
-                    raio_ficha * 2,
-                    raio_ficha * 2
-                };
-                SDL_RenderCopy(renderer, ficha, NULL, &destino);
-            }
-        }
+        // Painel visível com a IA pensando: atualiza o tempo de busca de tempos em tempos
+        if (thread_ia && painel_precisa_atualizar(&painel)) redesenhar = true;
 
-        // Desenha a imagem do tabuleiro sobre as peças
-        SDL_Rect quad1 = {200, 150 , 447 , 358};
-        SDL_RenderCopy(renderer, tabuleiro, NULL, &quad1);
+        // Troca de tela (botões do menu e da tela final); cliques que não mudam nada não redesenham
+        if (estado_atual != estado_desenhado) redesenhar = true;
 
-        // Se for a tela final, mostra a imagem do vencedor
-        if (estado_atual == FINAL) {
-            SDL_RenderCopy(renderer, (jogador_vencedor == 1 ? vencedor1 : vencedor2), NULL, NULL);
-        }
+        // Nada mudou: volta a esperar sem redesenhar (menu e tela final parados são desenhados uma vez só)
+        if (!redesenhar) continue;
+        redesenhar = false;
+        estado_desenhado = estado_atual;
+        painel_inicio_quadro(&painel);
+        char estado_ia[PAINEL_COLUNAS + 1];
+        descrever_ia(estado_ia, sizeof(estado_ia), inicio_pausa_ia);
 
+        // Renderiza a tela
+        painel_contar_desenhos(&painel, desenhar_tela(renderer, &tela, interpolacao));
+        painel_desenhar(&painel, renderer, contar_animacoes(), estado_ia);
         SDL_RenderPresent(renderer);
-        SDL_Delay(10); // Controla FPS (ajusta performance do loop)
+        ritmo_quadro_apresentado(&ritmo, quadro_animado);
+        painel_quadro_apresentado(&painel, quadro_animado);
     }
 
+    // Para a IA antes de liberar a tabela que ela usa
+    cancelar_ia();
+    ritmo_registrar(&ritmo);
+
     // Libera recursos e encerra SDL
-    SDL_DestroyTexture(menu_img);
-    SDL_DestroyTexture(tabuleiro);
-    SDL_DestroyTexture(ficha_vermelha);
-    SDL_DestroyTexture(ficha_amarela);
-    SDL_DestroyTexture(vencedor1);
-    SDL_DestroyTexture(vencedor2);
+    painel_destruir(&painel);
+    liberar_recursos(&tela);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
+    tt_destruir(&tabela_ia);
+    cache_fechar(&cache_ia);
+    solucao_fechar(&solucao_ia);
     IMG_Quit();
     SDL_Quit();
 
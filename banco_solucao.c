@@ -0,0 +1,459 @@
+/*
+    Banco de solução completa por análise retrógrada (ver banco_solucao.h).
+*/
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // mmap com -std=c11
+#endif
+
+#include "banco_solucao.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SOLUCAO_VERSAO 1
+#define BITS_BLOCO 16 // Blocos de 2^16 posições por tarefa da geração (múltiplo de 32: cada palavra tem um dono só)
+
+// Número de vetores de alturas: (LINHAS + 1) ^ COLUNAS
+#define NUM_VETORES_ALTURAS (potencia_alturas[COLUNAS])
+
+// Cabeçalho no início do arquivo
+typedef struct {
+    char magica[4];          // "C4SB"
+    uint32_t versao;
+    uint32_t linhas, colunas;
+    uint64_t num_posicoes;
+    uint8_t reservado[40];
+} CabecalhoSolucao;
+
+static uint64_t binomio[TOTAL_CASAS + 1][TOTAL_CASAS / 2 + 2]; // binomio[n][k] = C(n, k)
+static uint32_t potencia_alturas[COLUNAS + 1];                // (LINHAS + 1) ^ i
+static bool tabelas_prontas = false;
+
+static void preparar_tabelas(void) {
+    if (tabelas_prontas) return;
+    for (int n = 0; n <= TOTAL_CASAS; n++) {
+        for (int k = 0; k <= TOTAL_CASAS / 2 + 1; k++) {
+            if (k == 0) binomio[n][k] = 1;
+            else if (n == 0) binomio[n][k] = 0;
+            else binomio[n][k] = binomio[n - 1][k - 1] + binomio[n - 1][k];
+        }
+    }
+    potencia_alturas[0] = 1;
+    for (int i = 1; i <= COLUNAS; i++) potencia_alturas[i] = potencia_alturas[i - 1] * (LINHAS + 1);
+    tabelas_prontas = true;
+}
+
+// Peças no tabuleiro de um vetor de alturas (coluna 0 no dígito menos significativo)
+static int pecas_do_vetor(uint32_t vetor) {
+    int k = 0;
+    for (int c = 0; c < COLUNAS; c++) {
+        k += (int)(vetor % (LINHAS + 1));
+        vetor /= LINHAS + 1;
+    }
+    return k;
+}
+
+// Posições de cada vetor de alturas: as palavras de k bits com ceil(k/2) bits ligados
+static uint64_t posicoes_do_vetor(uint32_t vetor) {
+    int k = pecas_do_vetor(vetor);
+    return binomio[k][(k + 1) / 2];
+}
+
+/*
+    Monta a tabela de deslocamentos (camada por camada, vetores em ordem
+    crescente dentro da camada). Se `ordem` e `inicio_camada` não forem NULL,
+    devolve também os vetores na ordem do índice e onde começa cada camada.
+*/
+static uint64_t* montar_deslocamentos(uint32_t* ordem, uint32_t inicio_camada[TOTAL_CASAS + 2], uint64_t* total) {
+    uint64_t* deslocamentos = malloc((size_t)NUM_VETORES_ALTURAS * sizeof(uint64_t));
+    if (!deslocamentos) return NULL;
+    uint64_t soma = 0;
+    uint32_t n = 0;
+    for (int k = 0; k <= TOTAL_CASAS; k++) {
+        if (inicio_camada) inicio_camada[k] = n;
+        for (uint32_t v = 0; v < NUM_VETORES_ALTURAS; v++) {
+            if (pecas_do_vetor(v) != k) continue;
+            deslocamentos[v] = soma;
+            soma += posicoes_do_vetor(v);
+            if (ordem) ordem[n] = v;
+            n++;
+        }
+    }
+    if (inicio_camada) inicio_camada[TOTAL_CASAS + 1] = n;
+    *total = soma;
+    return deslocamentos;
+}
+
+uint64_t solucao_num_posicoes(void) {
+    preparar_tabelas();
+    // Soma por número de peças sem montar a tabela (o 7x6 teria 823543 vetores)
+    uint64_t vetores_por_pecas[TOTAL_CASAS + 1] = {1};
+    for (int c = 0; c < COLUNAS; c++) {
+        for (int k = TOTAL_CASAS; k >= 0; k--) {
+            uint64_t soma = 0;
+            for (int h = 0; h <= LINHAS && h <= k; h++) soma += vetores_por_pecas[k - h];
+            vetores_por_pecas[k] = soma;
+        }
+    }
+    double total = 0; // Em double para não estourar nos tabuleiros grandes
+    for (int k = 0; k <= TOTAL_CASAS; k++) total += (double)vetores_por_pecas[k] * (double)binomio[k][(k + 1) / 2];
+    return total > (double)SOLUCAO_MAXIMO_POSICOES ? 0 : (uint64_t)total;
+}
+
+// Índice da posição no banco
+static uint64_t indice_posicao(const uint64_t* deslocamentos, const Posicao* p) {
+    uint64_t primeiro = p->jogadas % 2 == 0 ? p->atual : pecas_adversario(p); // Peças do jogador 1
+    uint32_t vetor = 0;
+    uint64_t posto = 0;
+    int bit = 0, ligados = 0;
+    for (int c = 0; c < COLUNAS; c++) {
+        uint64_t coluna = primeiro >> (c * ALTURA);
+        int h = CONTAR_BITS(p->mascara & mascara_coluna(c));
+        vetor += (uint32_t)h * potencia_alturas[c];
+        for (int i = 0; i < h; i++, bit++)
+            if (coluna >> i & 1) posto += binomio[bit][++ligados];
+    }
+    return deslocamentos[vetor] + posto;
+}
+
+static int valor_no_indice(const uint64_t* valores, uint64_t indice) {
+    return (int)(valores[indice >> 5] >> ((indice & 31) * 2) & 3);
+}
+
+int solucao_consultar(const BancoSolucao* banco, const Posicao* p) {
+    if (!banco->valores) return SOLUCAO_DESCONHECIDA;
+    return valor_no_indice(banco->valores, indice_posicao(banco->deslocamentos, p));
+}
+
+bool solucao_melhor_jogada(const BancoSolucao* banco, const Posicao* p, int* coluna, int* pontuacao) {
+    if (solucao_consultar(banco, p) == SOLUCAO_DESCONHECIDA) return false;
+    for (int c = 0; c < COLUNAS; c++) {
+        if (pode_jogar(p, c) && jogada_vencedora(p, c)) {
+            *coluna = c;
+            *pontuacao = PONTUACAO_VITORIA - (p->jogadas + 1);
+            return true;
+        }
+    }
+    int melhor_valor = SOLUCAO_DESCONHECIDA, melhor_avaliacao = 0;
+    *coluna = -1;
+    for (int c = 0; c < COLUNAS; c++) {
+        if (!pode_jogar(p, c)) continue;
+        Posicao filho = *p;
+        jogar_coluna(&filho, c);
+        int valor_filho = solucao_consultar(banco, &filho);
+        if (valor_filho == SOLUCAO_DESCONHECIDA) continue;
+        int valor = SOLUCAO_VITORIA + SOLUCAO_DERROTA - valor_filho;
+        int avaliacao = -avaliar_posicao(&filho);
+        if (valor > melhor_valor || (valor == melhor_valor && avaliacao > melhor_avaliacao)) {
+            melhor_valor = valor;
+            melhor_avaliacao = avaliacao;
+            *coluna = c;
+        }
+    }
+    if (*coluna < 0) return false;
+    if (melhor_valor == SOLUCAO_VITORIA) *pontuacao = PONTUACAO_MINIMA_VITORIA;
+    else if (melhor_valor == SOLUCAO_DERROTA) *pontuacao = -PONTUACAO_MINIMA_VITORIA;
+    else *pontuacao = 0;
+    return true;
+}
+
+/*
+    Geração
+*/
+
+typedef struct {
+    uint64_t* valores;
+    const uint64_t* deslocamentos;
+    const uint32_t* ordem;           // Vetores de alturas na ordem do índice
+    const uint32_t* inicio_camada;
+    int camada;                      // Número de peças das posições em resolução
+    uint64_t primeiro, fim;          // Faixa de índices da camada
+    SDL_atomic_t proximo_bloco;      // Próximo bloco livre (relativo ao bloco de `primeiro`)
+    uint64_t num_blocos;
+} TarefaCamada;
+
+// Palavra de `k` bits com `ligados` bits e posto colexicográfico `posto`
+static uint64_t palavra_do_posto(uint64_t posto, int ligados, int k) {
+    uint64_t palavra = 0;
+    int limite = k;
+    for (int i = ligados; i >= 1; i--) {
+        int b = i - 1;
+        while (b + 1 < limite && binomio[b + 1][i] <= posto) b++;
+        palavra |= UINT64_C(1) << b;
+        posto -= binomio[b][i];
+        limite = b;
+    }
+    return palavra;
+}
+
+// Próxima palavra com o mesmo número de bits ligados (truque de Gosper)
+static uint64_t proxima_palavra(uint64_t x) {
+    uint64_t menor = x & (~x + 1);
+    uint64_t soma = x + menor;
+    return (((soma ^ x) >> 2) / menor) | soma;
+}
+
+// Monta a posição a partir do vetor de alturas e das peças do jogador 1 em sequência
+static Posicao montar_posicao(const int alturas[COLUNAS], uint64_t palavra, int k) {
+    Posicao p;
+    uint64_t primeiro = 0;
+    p.mascara = 0;
+    int bit = 0;
+    for (int c = 0; c < COLUNAS; c++) {
+        uint64_t bits_coluna = (UINT64_C(1) << alturas[c]) - 1;
+        primeiro |= (palavra >> bit & bits_coluna) << (c * ALTURA);
+        p.mascara |= bits_coluna << (c * ALTURA);
+        bit += alturas[c];
+    }
+    p.jogadas = k;
+    p.atual = k % 2 == 0 ? primeiro : primeiro ^ p.mascara;
+    return p;
+}
+
+// Valor de uma posição a partir dos valores (já prontos) da camada seguinte
+static int resolver_posicao(const TarefaCamada* t, const Posicao* p) {
+    if (tem_alinhamento(p->atual) || tem_alinhamento(pecas_adversario(p))) return SOLUCAO_DESCONHECIDA;
+    if (p->jogadas == TOTAL_CASAS) return SOLUCAO_EMPATE;
+    for (int c = 0; c < COLUNAS; c++)
+        if (pode_jogar(p, c) && jogada_vencedora(p, c)) return SOLUCAO_VITORIA;
+    int melhor = SOLUCAO_DERROTA;
+    for (int c = 0; c < COLUNAS; c++) {
+        if (!pode_jogar(p, c)) continue;
+        Posicao filho = *p;
+        jogar_coluna(&filho, c);
+        int valor = SOLUCAO_VITORIA + SOLUCAO_DERROTA - valor_no_indice(t->valores, indice_posicao(t->deslocamentos, &filho));
+        if (valor > melhor) {
+            melhor = valor;
+            if (melhor == SOLUCAO_VITORIA) break;
+        }
+    }
+    return melhor;
+}
+
+// Resolve as posições de índice [de, ate) da camada
+static void resolver_bloco(const TarefaCamada* t, uint64_t de, uint64_t ate) {
+    int k = t->camada, ligados = (k + 1) / 2;
+    uint64_t por_vetor = binomio[k][ligados];
+
+    // Vetor de alturas que contém `de`: o último da camada com deslocamento <= de
+    uint32_t baixo = t->inicio_camada[k], alto = t->inicio_camada[k + 1] - 1;
+    while (baixo < alto) {
+        uint32_t meio = (baixo + alto + 1) / 2;
+        if (t->deslocamentos[t->ordem[meio]] <= de) baixo = meio;
+        else alto = meio - 1;
+    }
+    uint32_t j = baixo;
+    int alturas[COLUNAS];
+    uint32_t vetor = t->ordem[j];
+    for (int c = 0; c < COLUNAS; c++, vetor /= LINHAS + 1) alturas[c] = (int)(vetor % (LINHAS + 1));
+    uint64_t posto = de - t->deslocamentos[t->ordem[j]];
+    uint64_t palavra = palavra_do_posto(posto, ligados, k);
+
+    uint64_t acumulado = 0, indice_palavra = de >> 5;
+    for (uint64_t i = de; i < ate; i++) {
+        if (i >> 5 != indice_palavra) {
+            t->valores[indice_palavra] |= acumulado;
+            acumulado = 0;
+            indice_palavra = i >> 5;
+        }
+        Posicao p = montar_posicao(alturas, palavra, k);
+        acumulado |= (uint64_t)resolver_posicao(t, &p) << ((i & 31) * 2);
+
+        if (++posto == por_vetor) {
+            // Fim deste vetor de alturas: passa ao próximo da camada
+            if (++j == t->inicio_camada[k + 1]) break;
+            vetor = t->ordem[j];
+            for (int c = 0; c < COLUNAS; c++, vetor /= LINHAS + 1) alturas[c] = (int)(vetor % (LINHAS + 1));
+            posto = 0;
+            palavra = (UINT64_C(1) << ligados) - 1;
+        } else {
+            palavra = proxima_palavra(palavra);
+        }
+    }
+    t->valores[indice_palavra] |= acumulado;
+}
+
+// Corpo das threads da geração: pega blocos da camada até acabarem
+static int trabalhar_camada(void* dados) {
+    TarefaCamada* t = dados;
+    for (;;) {
+        uint64_t bloco = (uint64_t)SDL_AtomicAdd(&t->proximo_bloco, 1);
+        if (bloco >= t->num_blocos) break;
+        // Blocos alinhados em múltiplos de 2^BITS_BLOCO do índice absoluto
+        uint64_t de = ((t->primeiro >> BITS_BLOCO) + bloco) << BITS_BLOCO;
+        uint64_t ate = de + (UINT64_C(1) << BITS_BLOCO);
+        if (de < t->primeiro) de = t->primeiro;
+        if (ate > t->fim) ate = t->fim;
+        resolver_bloco(t, de, ate);
+    }
+    return 0;
+}
+
+bool solucao_gerar(const char* caminho, int num_threads) {
+    uint64_t num_posicoes = solucao_num_posicoes();
+    if (num_posicoes == 0) {
+        printf("Tabuleiro %dx%d grande demais para o banco de solucao\n", COLUNAS, LINHAS);
+        return false;
+    }
+    if (num_threads <= 0) num_threads = SDL_GetCPUCount();
+    if (num_threads > 64) num_threads = 64;
+
+    uint32_t* ordem = malloc((size_t)NUM_VETORES_ALTURAS * sizeof(uint32_t));
+    uint32_t inicio_camada[TOTAL_CASAS + 2];
+    uint64_t total;
+    uint64_t* deslocamentos = ordem ? montar_deslocamentos(ordem, inicio_camada, &total) : NULL;
+    uint64_t num_palavras = (num_posicoes + 31) / 32;
+    uint64_t* valores = deslocamentos ? calloc((size_t)num_palavras, sizeof(uint64_t)) : NULL;
+    if (!valores) {
+        printf("Sem memoria para %llu posicoes\n", (unsigned long long)num_posicoes);
+        free(deslocamentos);
+        free(ordem);
+        return false;
+    }
+    printf("Tabuleiro %dx%d: %llu posicoes (%.1f MB), %d threads\n", COLUNAS, LINHAS,
+           (unsigned long long)num_posicoes, (double)num_palavras * 8 / (1024 * 1024), num_threads);
+
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    for (int k = TOTAL_CASAS; k >= 0; k--) {
+        Uint64 inicio_camada_k = SDL_GetPerformanceCounter();
+        TarefaCamada t;
+        t.valores = valores;
+        t.deslocamentos = deslocamentos;
+        t.ordem = ordem;
+        t.inicio_camada = inicio_camada;
+        t.camada = k;
+        t.primeiro = deslocamentos[ordem[inicio_camada[k]]];
+        t.fim = k == TOTAL_CASAS ? total : deslocamentos[ordem[inicio_camada[k + 1]]];
+        t.num_blocos = ((t.fim - 1) >> BITS_BLOCO) - (t.primeiro >> BITS_BLOCO) + 1;
+        SDL_AtomicSet(&t.proximo_bloco, 0);
+
+        // Camadas pequenas não compensam criar threads
+        int n = t.num_blocos < (uint64_t)num_threads ? (int)t.num_blocos : num_threads;
+        SDL_Thread* threads[64];
+        for (int i = 1; i < n; i++) threads[i] = SDL_CreateThread(trabalhar_camada, "solucao", &t);
+        trabalhar_camada(&t);
+        for (int i = 1; i < n; i++)
+            if (threads[i]) SDL_WaitThread(threads[i], NULL);
+
+        printf("  camada %2d: %12llu posicoes em %.2f s\n", k, (unsigned long long)(t.fim - t.primeiro),
+               (double)(SDL_GetPerformanceCounter() - inicio_camada_k) / frequencia);
+    }
+
+    Posicao vazia = {0, 0, 0};
+    int valor_inicial = valor_no_indice(valores, indice_posicao(deslocamentos, &vazia));
+    static const char* const nomes[] = {"?", "derrota", "empate", "vitoria"};
+    printf("Gerado em %.1f s: o primeiro jogador tem %s\n",
+           (double)(SDL_GetPerformanceCounter() - inicio) / frequencia, nomes[valor_inicial]);
+
+    // Grava o cabeçalho e os valores
+    CabecalhoSolucao cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "C4SB", 4);
+    cab.versao = SOLUCAO_VERSAO;
+    cab.linhas = LINHAS;
+    cab.colunas = COLUNAS;
+    cab.num_posicoes = num_posicoes;
+    FILE* arquivo = fopen(caminho, "wb");
+    bool ok = arquivo && fwrite(&cab, sizeof(cab), 1, arquivo) == 1 &&
+              fwrite(valores, sizeof(uint64_t), (size_t)num_palavras, arquivo) == (size_t)num_palavras;
+    if (arquivo && fclose(arquivo) != 0) ok = false;
+    if (!ok) {
+        printf("Nao foi possivel gravar %s\n", caminho);
+        remove(caminho);
+    }
+    free(valores);
+    free(deslocamentos);
+    free(ordem);
+    return ok;
+}
+
+/*
+    Leitura
+*/
+
+static void liberar(BancoSolucao* banco) {
+#ifdef _WIN32
+    if (banco->mapa) UnmapViewOfFile(banco->mapa);
+    if (banco->mapeamento) CloseHandle((HANDLE)banco->mapeamento);
+    if (banco->arquivo && banco->arquivo != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)banco->arquivo);
+#else
+    if (banco->mapa) munmap(banco->mapa, (size_t)banco->tamanho);
+    if (banco->descritor >= 0) close(banco->descritor);
+#endif
+    free(banco->deslocamentos);
+    memset(banco, 0, sizeof(*banco));
+#ifndef _WIN32
+    banco->descritor = -1;
+#endif
+}
+
+bool solucao_abrir(BancoSolucao* banco, const char* caminho) {
+    memset(banco, 0, sizeof(*banco));
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) return false;
+    banco->arquivo = arquivo;
+    LARGE_INTEGER tamanho;
+    if (!GetFileSizeEx(arquivo, &tamanho) || tamanho.QuadPart <= (LONGLONG)sizeof(CabecalhoSolucao)) {
+        liberar(banco);
+        return false;
+    }
+    banco->tamanho = (uint64_t)tamanho.QuadPart;
+    banco->mapeamento = CreateFileMappingA(arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (banco->mapeamento) banco->mapa = MapViewOfFile((HANDLE)banco->mapeamento, FILE_MAP_READ, 0, 0, 0);
+#else
+    banco->descritor = open(caminho, O_RDONLY);
+    if (banco->descritor < 0) return false;
+    struct stat info;
+    if (fstat(banco->descritor, &info) != 0 || (uint64_t)info.st_size <= sizeof(CabecalhoSolucao)) {
+        liberar(banco);
+        return false;
+    }
+    banco->tamanho = (uint64_t)info.st_size;
+    banco->mapa = mmap(NULL, (size_t)banco->tamanho, PROT_READ, MAP_SHARED, banco->descritor, 0);
+    if (banco->mapa == MAP_FAILED) banco->mapa = NULL;
+#endif
+    if (!banco->mapa) {
+        SDL_Log("Solucao: falha ao mapear %s", caminho);
+        liberar(banco);
+        return false;
+    }
+
+    const CabecalhoSolucao* cab = (const CabecalhoSolucao*)banco->mapa;
+    uint64_t num_posicoes = solucao_num_posicoes();
+    if (memcmp(cab->magica, "C4SB", 4) != 0 || cab->versao != SOLUCAO_VERSAO || cab->linhas != LINHAS ||
+        cab->colunas != COLUNAS || cab->num_posicoes != num_posicoes ||
+        banco->tamanho < sizeof(CabecalhoSolucao) + (num_posicoes + 31) / 32 * sizeof(uint64_t)) {
+        SDL_Log("Solucao: %s nao e um banco deste tabuleiro", caminho);
+        liberar(banco);
+        return false;
+    }
+    uint64_t total;
+    banco->deslocamentos = montar_deslocamentos(NULL, NULL, &total);
+    if (!banco->deslocamentos) {
+        liberar(banco);
+        return false;
+    }
+    banco->num_posicoes = num_posicoes;
+    banco->valores = (const uint64_t*)((const char*)banco->mapa + sizeof(CabecalhoSolucao));
+    return true;
+}
+
+void solucao_fechar(BancoSolucao* banco) {
+    if (!banco->mapa) return;
+    liberar(banco);
+}
@@ -0,0 +1,84 @@
+/*
+    Banco de solução completa para tabuleiros pequenos (análise retrógrada).
+
+    Guarda o valor exato (vitória, empate ou derrota de quem está na vez) de
+    todas as posições do tabuleiro compilado, com 2 bits por posição. Com o
+    banco aberto, a IA escolhe a jogada consultando as posições seguintes,
+    sem busca nenhuma.
+
+    Índice das posições: as posições são agrupadas pelo vetor de alturas das
+    colunas, em ordem de número de peças (k). Dentro de cada grupo, as peças
+    do primeiro jogador, lidas coluna a coluna da base para o topo, formam
+    uma palavra de k bits com exatamente ceil(k/2) bits ligados, numerada
+    pelo sistema combinatório (ordem colexicográfica). Assim cada posição com
+    a contagem de peças certa tem um índice próprio, sem espaço reservado
+    para posições impossíveis:
+
+      4x4 ~ 50 KB, 5x4 ~ 1,3 MB, 6x4 ~ 38 MB, 7x4 ~ 1,1 GB, 6x5 ~ 2,4 GB
+
+    (COLUNAS x LINHAS). O 7x6 padrão é grande demais (~17 TB) e é recusado.
+
+    A geração resolve as camadas da última (tabuleiro cheio) para a primeira.
+    Cada posição depende só da camada seguinte, então cada camada é dividida
+    em blocos de posições consecutivas resolvidos em paralelo por várias
+    threads.
+
+    Formato do arquivo: cabeçalho de 64 bytes ("C4SB", versão, linhas,
+    colunas, número de posições) seguido dos valores, 32 posições por
+    palavra de 64 bits, na ordem de bytes da máquina que o gerou.
+*/
+
+#ifndef BANCO_SOLUCAO_H
+#define BANCO_SOLUCAO_H
+
+#include "motor.h"
+
+#define SOLUCAO_MAXIMO_POSICOES (UINT64_C(1) << 35) // Limite do banco (8 GB)
+
+// Valor de uma posição para o jogador da vez
+enum {
+    SOLUCAO_DESCONHECIDA = 0, // Fora do banco (ou posição com 4 em linha)
+    SOLUCAO_DERROTA,
+    SOLUCAO_EMPATE,
+    SOLUCAO_VITORIA
+};
+
+typedef struct {
+    const uint64_t* valores;   // 2 bits por posição (dentro do arquivo mapeado)
+    uint64_t num_posicoes;
+    uint64_t* deslocamentos;   // Primeiro índice de cada vetor de alturas
+    void* mapa;                // Arquivo inteiro mapeado em memória
+    uint64_t tamanho;
+#ifdef _WIN32
+    void* arquivo;
+    void* mapeamento;
+#else
+    int descritor;
+#endif
+} BancoSolucao;
+
+// Número de posições do banco para o tabuleiro compilado (0 se passar de SOLUCAO_MAXIMO_POSICOES)
+uint64_t solucao_num_posicoes(void);
+
+/*
+    Gera o banco e grava em `caminho`, usando `num_threads` threads (0 = uma
+    por núcleo). Mostra o progresso de cada camada na saída padrão.
+*/
+bool solucao_gerar(const char* caminho, int num_threads);
+
+// Mapeia um banco gerado para este tabuleiro (somente leitura)
+bool solucao_abrir(BancoSolucao* banco, const char* caminho);
+void solucao_fechar(BancoSolucao* banco);
+
+// Valor da posição para o jogador da vez (SOLUCAO_*)
+int solucao_consultar(const BancoSolucao* banco, const Posicao* p);
+
+/*
+    Melhor jogada pelo banco: vitória imediata, senão a jogada de melhor
+    valor exato, com a avaliação estática desempatando. A pontuação segue a
+    convenção da busca, mas vitórias e derrotas vêm sem a distância (ficam em
+    ±PONTUACAO_MINIMA_VITORIA). Retorna false se a posição não está no banco.
+*/
+bool solucao_melhor_jogada(const BancoSolucao* banco, const Posicao* p, int* coluna, int* pontuacao);
+
+#endif
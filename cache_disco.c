@@ -0,0 +1,260 @@
+/*
+    Cache persistente de análises em disco (ver cache_disco.h).
+*/
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // ftruncate e mmap com -std=c11
+#endif
+
+#include "cache_disco.h"
+
+#include <SDL2/SDL.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if TOTAL_CASAS > 127
+#error "Pontuação compacta do cache em disco não cabe em 8 bits"
+#endif
+
+#define CACHE_VERSAO 1
+
+// Cabeçalho no início do arquivo (64 bytes, na ordem de bytes da máquina que o criou)
+typedef struct {
+    char magica[4];          // "C4CD"
+    uint32_t versao;
+    uint32_t linhas, colunas;
+    uint64_t num_entradas;
+    uint8_t reservado[40];
+} CabecalhoCache;
+
+#define CACHE_MASCARA_CHAVE ((UINT64_C(1) << CACHE_BITS_CHAVE) - 1)
+#define CACHE_DESLOC_COLUNA CACHE_BITS_CHAVE
+#define CACHE_DESLOC_VALOR (CACHE_BITS_CHAVE + 4)
+#define CACHE_BIT_OCUPADA (UINT64_C(1) << 63)
+
+// Leitura e troca atômicas de uma entrada (o arquivo pode estar mapeado por outros processos)
+#if defined(_MSC_VER)
+#include <intrin.h>
+static uint64_t ler_entrada(uint64_t* e) {
+    return (uint64_t)*(volatile __int64*)e;
+}
+static bool trocar_entrada_vazia(uint64_t* e, uint64_t nova) {
+    return _InterlockedCompareExchange64((volatile __int64*)e, (__int64)nova, 0) == 0;
+}
+#else
+static uint64_t ler_entrada(uint64_t* e) {
+    return __atomic_load_n(e, __ATOMIC_ACQUIRE);
+}
+static bool trocar_entrada_vazia(uint64_t* e, uint64_t nova) {
+    uint64_t esperado = 0;
+    return __atomic_compare_exchange_n(e, &esperado, nova, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+// Chave da posição refletida horizontalmente (a coluna c vai para COLUNAS - 1 - c)
+static uint64_t espelhar_chave(uint64_t chave) {
+    uint64_t espelho = 0;
+    for (int c = 0; c < COLUNAS; c++) {
+        uint64_t bits = (chave >> (c * ALTURA)) & ((UINT64_C(1) << ALTURA) - 1);
+        espelho |= bits << ((COLUNAS - 1 - c) * ALTURA);
+    }
+    return espelho;
+}
+
+/*
+    Chave canônica: a menor entre a chave e a do espelho. Como atual ⊆ mascara,
+    a soma atual + mascara nunca propaga "vai um" de uma coluna para a vizinha,
+    então espelhar a chave equivale a espelhar a posição.
+*/
+static uint64_t chave_canonica(const Posicao* p, bool* espelhada) {
+    uint64_t chave = p->atual + p->mascara;
+    uint64_t espelho = espelhar_chave(chave);
+    *espelhada = espelho < chave;
+    return *espelhada ? espelho : chave;
+}
+
+static uint64_t casa_inicial(const CacheDisco* cache, uint64_t chave) {
+    return (chave * UINT64_C(0x9E3779B97F4A7C15) >> 16) % cache->num_entradas;
+}
+
+// Desfaz o mapeamento e fecha o arquivo (também usada nos caminhos de erro de cache_abrir)
+static void liberar(CacheDisco* cache) {
+#ifdef _WIN32
+    if (cache->mapa) UnmapViewOfFile(cache->mapa);
+    if (cache->mapeamento) CloseHandle((HANDLE)cache->mapeamento);
+    if (cache->arquivo && cache->arquivo != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)cache->arquivo);
+#else
+    if (cache->mapa) munmap(cache->mapa, (size_t)cache->tamanho);
+    if (cache->descritor >= 0) close(cache->descritor);
+#endif
+    memset(cache, 0, sizeof(*cache));
+#ifndef _WIN32
+    cache->descritor = -1;
+#endif
+}
+
+/*
+    Abre o arquivo existente ou cria um novo do tamanho pedido. Um arquivo
+    existente mantém o próprio tamanho; se não for um cache deste tabuleiro,
+    é recusado (e nunca sobrescrito).
+*/
+bool cache_abrir(CacheDisco* cache, const char* caminho, size_t megabytes) {
+    memset(cache, 0, sizeof(*cache));
+    uint64_t tamanho_novo = sizeof(CabecalhoCache) +
+                            (uint64_t)megabytes * 1024 * 1024 / sizeof(uint64_t) * sizeof(uint64_t);
+    uint64_t tamanho;
+
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                 NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) {
+        SDL_Log("Cache: nao foi possivel abrir %s", caminho);
+        return false;
+    }
+    cache->arquivo = arquivo;
+    LARGE_INTEGER tamanho_atual;
+    if (!GetFileSizeEx(arquivo, &tamanho_atual)) {
+        liberar(cache);
+        return false;
+    }
+    tamanho = (uint64_t)tamanho_atual.QuadPart;
+    if (tamanho == 0) tamanho = tamanho_novo; // O mapeamento estende o arquivo até o tamanho pedido
+    HANDLE mapeamento = CreateFileMappingA(arquivo, NULL, PAGE_READWRITE, (DWORD)(tamanho >> 32),
+                                           (DWORD)(tamanho & 0xFFFFFFFF), NULL);
+    if (!mapeamento) {
+        SDL_Log("Cache: falha ao mapear %s", caminho);
+        liberar(cache);
+        return false;
+    }
+    cache->mapeamento = mapeamento;
+    cache->mapa = MapViewOfFile(mapeamento, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)tamanho);
+#else
+    cache->descritor = open(caminho, O_RDWR | O_CREAT, 0644);
+    if (cache->descritor < 0) {
+        SDL_Log("Cache: nao foi possivel abrir %s", caminho);
+        return false;
+    }
+    struct stat info;
+    if (fstat(cache->descritor, &info) != 0) {
+        liberar(cache);
+        return false;
+    }
+    tamanho = (uint64_t)info.st_size;
+    if (tamanho == 0) {
+        tamanho = tamanho_novo;
+        if (ftruncate(cache->descritor, (off_t)tamanho) != 0) {
+            SDL_Log("Cache: nao foi possivel criar %s", caminho);
+            liberar(cache);
+            return false;
+        }
+    }
+    cache->mapa = mmap(NULL, (size_t)tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, cache->descritor, 0);
+    if (cache->mapa == MAP_FAILED) cache->mapa = NULL;
+#endif
+    if (!cache->mapa || tamanho <= sizeof(CabecalhoCache)) {
+        SDL_Log("Cache: falha ao mapear %s", caminho);
+        liberar(cache);
+        return false;
+    }
+    cache->tamanho = tamanho;
+
+    // Arquivo novo (zerado): escreve o cabeçalho. Se dois processos criarem ao mesmo tempo, escrevem o mesmo conteúdo.
+    CabecalhoCache* cab = (CabecalhoCache*)cache->mapa;
+    uint64_t num_entradas = (tamanho - sizeof(CabecalhoCache)) / sizeof(uint64_t);
+    if (cab->versao == 0 && memcmp(cab->magica, "\0\0\0\0", 4) == 0) {
+        cab->versao = CACHE_VERSAO;
+        cab->linhas = LINHAS;
+        cab->colunas = COLUNAS;
+        cab->num_entradas = num_entradas;
+        memcpy(cab->magica, "C4CD", 4);
+    }
+    if (memcmp(cab->magica, "C4CD", 4) != 0 || cab->versao != CACHE_VERSAO || cab->linhas != LINHAS ||
+        cab->colunas != COLUNAS || cab->num_entradas == 0 || cab->num_entradas > num_entradas) {
+        SDL_Log("Cache: %s nao e um cache compativel com este tabuleiro", caminho);
+        liberar(cache);
+        return false;
+    }
+    cache->num_entradas = cab->num_entradas;
+    cache->entradas = (uint64_t*)((char*)cache->mapa + sizeof(CabecalhoCache));
+    return true;
+}
+
+void cache_fechar(CacheDisco* cache) {
+    if (!cache->mapa) return; // Nunca foi aberto (ou a abertura falhou)
+    if (cache->consultas)
+        SDL_Log("Cache: %llu consultas, %llu acertos, %llu gravacoes",
+                (unsigned long long)cache->consultas, (unsigned long long)cache->acertos,
+                (unsigned long long)cache->gravacoes);
+    liberar(cache);
+}
+
+bool cache_consultar(CacheDisco* cache, const Posicao* p, int* pontuacao, int* coluna) {
+    if (!cache->entradas) return false;
+    cache->consultas++;
+
+    bool espelhada;
+    uint64_t chave = chave_canonica(p, &espelhada);
+    uint64_t i = casa_inicial(cache, chave);
+    for (int s = 0; s < CACHE_SONDAGENS; s++) {
+        uint64_t e = ler_entrada(&cache->entradas[i]);
+        if (e == 0) return false; // Casa vazia: a posição nunca foi gravada
+        if ((e & CACHE_MASCARA_CHAVE) == chave) {
+            int c = (int)((e >> CACHE_DESLOC_COLUNA) & 0xF) - 1;
+            int compacta = (int)((e >> CACHE_DESLOC_VALOR) & 0xFF) - 128;
+            if (c < 0 || c >= COLUNAS) return false;
+            *coluna = espelhada ? COLUNAS - 1 - c : c;
+            // Pontuação compacta k > 0: vitória com TOTAL_CASAS + 1 - k peças no tabuleiro
+            if (compacta > 0) *pontuacao = PONTUACAO_VITORIA - (TOTAL_CASAS + 1 - compacta);
+            else if (compacta < 0) *pontuacao = -(PONTUACAO_VITORIA - (TOTAL_CASAS + 1 + compacta));
+            else *pontuacao = 0;
+            cache->acertos++;
+            return true;
+        }
+        if (++i == cache->num_entradas) i = 0;
+    }
+    return false;
+}
+
+/*
+    Grava a posição na primeira casa vazia da sequência de sondagem. Entradas
+    são imutáveis: se a posição já estiver lá (gravada por esta ou outra
+    execução), nada muda. Com a sequência cheia, o resultado é descartado.
+*/
+bool cache_gravar(CacheDisco* cache, const Posicao* p, int pontuacao, int coluna) {
+    if (!cache->entradas || coluna < 0 || coluna >= COLUNAS) return false;
+
+    int compacta;
+    if (pontuacao >= PONTUACAO_MINIMA_VITORIA) compacta = TOTAL_CASAS + 1 - (PONTUACAO_VITORIA - pontuacao);
+    else if (pontuacao <= -PONTUACAO_MINIMA_VITORIA) compacta = -(TOTAL_CASAS + 1 - (PONTUACAO_VITORIA + pontuacao));
+    else if (pontuacao == 0) compacta = 0;
+    else return false; // Pontuação heurística: não é um resultado provado
+
+    bool espelhada;
+    uint64_t chave = chave_canonica(p, &espelhada);
+    if (espelhada) coluna = COLUNAS - 1 - coluna;
+    uint64_t nova = CACHE_BIT_OCUPADA | chave | ((uint64_t)(coluna + 1) << CACHE_DESLOC_COLUNA) |
+                    ((uint64_t)(compacta + 128) << CACHE_DESLOC_VALOR);
+
+    uint64_t i = casa_inicial(cache, chave);
+    for (int s = 0; s < CACHE_SONDAGENS; s++) {
+        uint64_t e = ler_entrada(&cache->entradas[i]);
+        if (e == 0) {
+            if (trocar_entrada_vazia(&cache->entradas[i], nova)) {
+                cache->gravacoes++;
+                return true;
+            }
+            e = ler_entrada(&cache->entradas[i]); // Outro processo ocupou a casa primeiro
+        }
+        if ((e & CACHE_MASCARA_CHAVE) == chave) return true;
+        if (++i == cache->num_entradas) i = 0;
+    }
+    return false;
+}
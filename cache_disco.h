@@ -0,0 +1,57 @@
+/*
+    Cache persistente de análises em disco.
+
+    Guarda posições já resolvidas (vitória, derrota ou empate provados) em um
+    arquivo de hash mapeado em memória, que sobrevive entre execuções e pode
+    ser aberto por vários processos ao mesmo tempo.
+
+    Cada entrada ocupa 64 bits e é escrita de uma vez só com uma troca
+    atômica (compare-and-swap) numa casa vazia: entradas nunca mudam de lugar
+    nem são apagadas, então leitores não precisam de trava e escritores só
+    acrescentam. A chave é canônica (a menor entre a posição e seu espelho),
+    de modo que posições simétricas compartilham a mesma entrada.
+
+    Layout de uma entrada:
+      bits 0..BITS_CHAVE-1  chave da posição (atual + mascara)
+      4 bits seguintes      melhor coluna + 1
+      8 bits seguintes      pontuação compacta + 128 (ver cache_gravar)
+      bit 63                sempre 1 (distingue entrada de casa vazia)
+*/
+
+#ifndef CACHE_DISCO_H
+#define CACHE_DISCO_H
+
+#include "motor.h"
+
+#define CACHE_BITS_CHAVE (ALTURA * COLUNAS)
+#define CACHE_SONDAGENS 16 // Casas examinadas por consulta (sondagem linear)
+
+#if CACHE_BITS_CHAVE + 4 + 8 > 63
+#error "Tabuleiro grande demais para as entradas de 64 bits do cache em disco"
+#endif
+
+typedef struct {
+    void* mapa;           // Arquivo inteiro mapeado (cabeçalho + entradas)
+    uint64_t tamanho;     // Bytes mapeados
+    uint64_t* entradas;   // Início das entradas dentro do mapa
+    uint64_t num_entradas;
+#ifdef _WIN32
+    void* arquivo;        // HANDLE do arquivo
+    void* mapeamento;     // HANDLE do mapeamento
+#else
+    int descritor;
+#endif
+    uint64_t consultas, acertos, gravacoes; // Contadores deste processo
+} CacheDisco;
+
+// Abre (ou cria com `megabytes` MB) o arquivo de cache; retorna false em caso de erro
+bool cache_abrir(CacheDisco* cache, const char* caminho, size_t megabytes);
+void cache_fechar(CacheDisco* cache);
+
+// Procura a posição; em caso de acerto preenche a pontuação (escala da busca) e a melhor coluna
+bool cache_consultar(CacheDisco* cache, const Posicao* p, int* pontuacao, int* coluna);
+
+// Grava um resultado provado (a pontuação deve ser de vitória/derrota forçada ou de empate exato)
+bool cache_gravar(CacheDisco* cache, const Posicao* p, int pontuacao, int coluna);
+
+#endif
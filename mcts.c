@@ -0,0 +1,314 @@
+/*
+    Busca em árvore Monte Carlo sobre a arena de nós (ver mcts.h).
+*/
+
+#include "mcts.h"
+#include "playout.h"
+
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(NoMCTS) == 32, "NoMCTS deve ocupar 32 bytes");
+
+bool arena_criar(ArenaMCTS* arena, size_t megabytes) {
+    memset(arena, 0, sizeof(*arena));
+    uint64_t n = (uint64_t)megabytes * 1024 * 1024 / sizeof(NoMCTS);
+    if (n > UINT32_MAX - 64) n = UINT32_MAX - 64;
+    if (n == 0) return false;
+    uint64_t palavras = (n + 63) / 64;
+    arena->nos = malloc((size_t)n * sizeof(NoMCTS));
+    arena->vivos = malloc((size_t)palavras * sizeof(uint64_t));
+    arena->vivos_antes = malloc((size_t)palavras * sizeof(uint32_t));
+    if (!arena->nos || !arena->vivos || !arena->vivos_antes) {
+        arena_destruir(arena);
+        return false;
+    }
+    arena->capacidade = (uint32_t)n;
+    return true;
+}
+
+void arena_destruir(ArenaMCTS* arena) {
+    free(arena->nos);
+    free(arena->vivos);
+    free(arena->vivos_antes);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void arena_limpar(ArenaMCTS* arena) {
+    arena->usados = 0;
+}
+
+uint32_t arena_alocar(ArenaMCTS* arena, uint32_t n) {
+    if (arena->usados == 0 || n > arena->capacidade - arena->usados) {
+        arena->falhas++;
+        return 0;
+    }
+    uint32_t primeiro = arena->usados;
+    arena->usados += n;
+    arena->alocacoes++;
+    arena->nos_alocados += n;
+    return primeiro;
+}
+
+// Coloca p como única posição da árvore, no índice 0
+static void nova_raiz(ArenaMCTS* arena, const Posicao* p) {
+    NoMCTS* raiz = &arena->nos[0];
+    memset(raiz, 0, sizeof(*raiz));
+    raiz->atual = p->atual;
+    raiz->mascara = p->mascara;
+    raiz->jogadas = (uint8_t)p->jogadas;
+    raiz->coluna = -1;
+    arena->usados = 1;
+}
+
+static bool mesma_posicao(const NoMCTS* no, const Posicao* p) {
+    return no->mascara == p->mascara && no->atual == p->atual;
+}
+
+// Índice de p na árvore atual (raiz, filhos ou netos), ou UINT32_MAX se não estiver lá
+static uint32_t procurar_posicao(const ArenaMCTS* arena, const Posicao* p) {
+    const NoMCTS* raiz = &arena->nos[0];
+    if (mesma_posicao(raiz, p)) return 0;
+    for (uint32_t f = raiz->primeiro_filho; f < raiz->primeiro_filho + raiz->num_filhos; f++) {
+        const NoMCTS* filho = &arena->nos[f];
+        if (mesma_posicao(filho, p)) return f;
+        for (uint32_t n = filho->primeiro_filho; n < filho->primeiro_filho + filho->num_filhos; n++)
+            if (mesma_posicao(&arena->nos[n], p)) return n;
+    }
+    return UINT32_MAX;
+}
+
+// Novo índice do nó vivo i: quantos nós vivos existem antes dele
+static inline uint32_t novo_indice(const ArenaMCTS* arena, uint32_t i) {
+    return arena->vivos_antes[i >> 6] + (uint32_t)CONTAR_BITS(arena->vivos[i >> 6] & ((UINT64_C(1) << (i & 63)) - 1));
+}
+
+/*
+    Compactação deslizante: marca a subárvore da nova raiz, calcula o novo
+    índice de cada nó vivo (contagem de vivos antes dele) e copia os nós em
+    ordem crescente. Como o novo índice nunca passa do antigo e os filhos
+    vêm depois do pai, nenhum nó vivo é sobrescrito antes de ser copiado.
+*/
+static void compactar(ArenaMCTS* arena, uint32_t raiz) {
+    uint32_t palavras = (arena->usados + 63) / 64;
+    memset(arena->vivos, 0, palavras * sizeof(uint64_t));
+    arena->vivos[raiz >> 6] |= UINT64_C(1) << (raiz & 63);
+    for (uint32_t i = raiz; i < arena->usados; i++) {
+        if (!(arena->vivos[i >> 6] >> (i & 63) & 1)) continue;
+        const NoMCTS* no = &arena->nos[i];
+        for (uint32_t f = no->primeiro_filho; f < no->primeiro_filho + no->num_filhos; f++)
+            arena->vivos[f >> 6] |= UINT64_C(1) << (f & 63);
+    }
+
+    uint32_t total = 0;
+    for (uint32_t w = 0; w < palavras; w++) {
+        arena->vivos_antes[w] = total;
+        total += (uint32_t)CONTAR_BITS(arena->vivos[w]);
+    }
+
+    for (uint32_t i = raiz; i < arena->usados; i++) {
+        if (!(arena->vivos[i >> 6] >> (i & 63) & 1)) continue;
+        NoMCTS no = arena->nos[i];
+        if (no.num_filhos) no.primeiro_filho = novo_indice(arena, no.primeiro_filho);
+        arena->nos[novo_indice(arena, i)] = no;
+    }
+    arena->nos[0].coluna = -1;
+    arena->usados = total;
+}
+
+// Filho com maior UCB1 (filhos nunca visitados primeiro)
+static uint32_t selecionar(const ArenaMCTS* arena, uint32_t i) {
+    const NoMCTS* pai = &arena->nos[i];
+    double log_pai = log((double)pai->visitas);
+    uint32_t melhor = pai->primeiro_filho;
+    double melhor_valor = -1.0;
+    for (uint32_t f = pai->primeiro_filho; f < pai->primeiro_filho + pai->num_filhos; f++) {
+        const NoMCTS* filho = &arena->nos[f];
+        if (filho->visitas == 0) return f;
+        double valor = filho->pontos / (2.0 * filho->visitas) + MCTS_EXPLORACAO * sqrt(log_pai / filho->visitas);
+        if (valor > melhor_valor) {
+            melhor_valor = valor;
+            melhor = f;
+        }
+    }
+    return melhor;
+}
+
+// Cria um bloco com um filho por coluna livre; retorna false se a arena estiver cheia
+static bool expandir(ArenaMCTS* arena, uint32_t i) {
+    NoMCTS* no = &arena->nos[i];
+    Posicao p = {no->atual, no->mascara, no->jogadas};
+    uint32_t n = 0;
+    for (int c = 0; c < COLUNAS; c++) n += pode_jogar(&p, c);
+    uint32_t primeiro = arena_alocar(arena, n);
+    if (!primeiro) return false;
+
+    NoMCTS* filho = &arena->nos[primeiro];
+    for (int c = 0; c < COLUNAS; c++) {
+        if (!pode_jogar(&p, c)) continue;
+        Posicao q = p;
+        bool venceu = jogada_vencedora(&p, c);
+        jogar_coluna(&q, c);
+        memset(filho, 0, sizeof(*filho));
+        filho->atual = q.atual;
+        filho->mascara = q.mascara;
+        filho->jogadas = (uint8_t)q.jogadas;
+        filho->coluna = (int8_t)c;
+        filho->estado = venceu ? MCTS_VITORIA : q.jogadas == TOTAL_CASAS ? MCTS_EMPATE : MCTS_ABERTO;
+        filho++;
+    }
+    no->primeiro_filho = primeiro;
+    no->num_filhos = (uint8_t)n;
+    return true;
+}
+
+ResultadoMCTS mcts_buscar(ArenaMCTS* arena, const Posicao* p, int iteracoes, uint64_t semente) {
+    ResultadoMCTS r;
+    memset(&r, 0, sizeof(r));
+    r.coluna = -1;
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    uint64_t alocacoes_antes = arena->alocacoes;
+
+    // Reaproveita a subárvore da posição, se a busca anterior chegou até ela
+    uint32_t raiz = arena->usados ? procurar_posicao(arena, p) : UINT32_MAX;
+    if (raiz == UINT32_MAX) {
+        arena_limpar(arena);
+        nova_raiz(arena, p);
+    } else {
+        if (raiz != 0) compactar(arena, raiz);
+        r.nos_reaproveitados = arena->usados;
+    }
+
+    uint64_t rng = semente ? semente : 1;
+    const uint32_t k = PLAYOUT_VIAS;
+    for (int it = 0; it < iteracoes; it++) {
+        // Seleção: desce pelos nós já expandidos
+        uint32_t caminho[TOTAL_CASAS + 1];
+        int n = 0;
+        uint32_t i = 0;
+        caminho[n++] = 0;
+        while (arena->nos[i].num_filhos) {
+            i = selecionar(arena, i);
+            caminho[n++] = i;
+        }
+
+        // Expansão: uma folha já simulada ganha filhos e um deles é simulado
+        NoMCTS* no = &arena->nos[i];
+        if (no->estado == MCTS_ABERTO && no->visitas > 0 && expandir(arena, i)) {
+            i = no->primeiro_filho + (uint32_t)(xorshift64(&rng) % no->num_filhos);
+            caminho[n++] = i;
+            no = &arena->nos[i];
+        }
+
+        // Simulação: pontos de quem jogou até a folha
+        uint32_t pontos;
+        if (no->estado == MCTS_VITORIA) pontos = 2 * k;
+        else if (no->estado == MCTS_EMPATE) pontos = k;
+        else {
+            Posicao folha = {no->atual, no->mascara, no->jogadas};
+            ResultadoPlayouts rp;
+            playouts_vetoriais(&folha, (int)k, xorshift64(&rng), &rp);
+            pontos = (uint32_t)(2 * rp.derrotas + rp.empates); // Derrotas do jogador da vez na folha
+        }
+
+        // Retropropagação, trocando o ponto de vista a cada nível
+        for (int j = n - 1; j >= 0; j--) {
+            arena->nos[caminho[j]].visitas += k;
+            arena->nos[caminho[j]].pontos += pontos;
+            pontos = 2 * k - pontos;
+        }
+    }
+
+    const NoMCTS* raiz_no = &arena->nos[0];
+    uint32_t mais_visitas = 0;
+    for (uint32_t f = raiz_no->primeiro_filho; f < raiz_no->primeiro_filho + raiz_no->num_filhos; f++) {
+        const NoMCTS* filho = &arena->nos[f];
+        if (r.coluna < 0 || filho->visitas > mais_visitas) {
+            mais_visitas = filho->visitas;
+            r.coluna = filho->coluna;
+            r.taxa_vitoria = filho->visitas ? filho->pontos / (2.0 * filho->visitas) : 0.0;
+        }
+    }
+
+    r.iteracoes = iteracoes;
+    r.nos_arvore = arena->usados;
+    r.alocacoes = arena->alocacoes - alocacoes_antes;
+    r.segundos = (double)(SDL_GetPerformanceCounter() - inicio) / (double)SDL_GetPerformanceFrequency();
+    r.alocacoes_por_segundo = r.segundos > 0 ? (double)r.alocacoes / r.segundos : 0.0;
+    return r;
+}
+
+// Alocações de um nó por segundo: arena contra malloc/free, para o mesmo número de nós
+static void comparar_alocacao(ArenaMCTS* arena, uint32_t num_nos) {
+    void** ponteiros = malloc(sizeof(void*) * num_nos);
+    if (!ponteiros) return;
+    double freq = (double)SDL_GetPerformanceFrequency();
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (uint32_t i = 0; i < num_nos; i++) {
+        ponteiros[i] = malloc(sizeof(NoMCTS));
+        if (ponteiros[i]) ((NoMCTS*)ponteiros[i])->visitas = i;
+    }
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    for (uint32_t i = 0; i < num_nos; i++) free(ponteiros[i]);
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    Posicao vazio = {0, 0, 0};
+    arena_limpar(arena);
+    nova_raiz(arena, &vazio);
+    Uint64 t3 = SDL_GetPerformanceCounter();
+    for (uint32_t i = 0; i < num_nos; i++) {
+        uint32_t indice = arena_alocar(arena, 1);
+        if (!indice) break;
+        arena->nos[indice].visitas = i;
+    }
+    Uint64 t4 = SDL_GetPerformanceCounter();
+    arena_limpar(arena);
+    Uint64 t5 = SDL_GetPerformanceCounter();
+    free(ponteiros);
+
+    printf("malloc: %.0f alocacoes/s, liberar %u nos em %.3f ms\n",
+           num_nos / ((t1 - t0) / freq), num_nos, 1000.0 * (t2 - t1) / freq);
+    printf("arena:  %.0f alocacoes/s, liberar %u nos em %.3f ms\n",
+           num_nos / ((t4 - t3) / freq), num_nos, 1000.0 * (t5 - t4) / freq);
+}
+
+void benchmark_mcts(int iteracoes_por_jogada) {
+    ArenaMCTS arena;
+    if (!arena_criar(&arena, 64)) {
+        printf("Sem memoria para a arena\n");
+        return;
+    }
+
+    // Autojogo: as duas cores usam a mesma arena, então cada busca herda a árvore da anterior
+    Posicao p = {0, 0, 0};
+    uint32_t maior_arvore = 0;
+    double segundos = 0.0;
+    uint64_t alocacoes = 0;
+    while (p.jogadas < TOTAL_CASAS) {
+        ResultadoMCTS r = mcts_buscar(&arena, &p, iteracoes_por_jogada, 1000 + (uint64_t)p.jogadas);
+        if (r.coluna < 0) break;
+        printf("jogada %2d: coluna %d (%.1f%%), %u nos (%u reaproveitados), %.0f alocacoes/s\n",
+               p.jogadas + 1, r.coluna + 1, 100.0 * r.taxa_vitoria, r.nos_arvore, r.nos_reaproveitados,
+               r.alocacoes_por_segundo);
+        if (r.nos_arvore > maior_arvore) maior_arvore = r.nos_arvore;
+        segundos += r.segundos;
+        alocacoes += r.alocacoes;
+        bool venceu = jogada_vencedora(&p, r.coluna);
+        jogar_coluna(&p, r.coluna);
+        if (venceu) break;
+    }
+
+    double rascunho = (sizeof(uint64_t) + sizeof(uint32_t)) / 64.0;
+    printf("No: %u bytes (+%.3f de rascunho da compactacao); maior arvore %u nos = %.1f MB de %u nos disponiveis\n",
+           (unsigned)sizeof(NoMCTS), rascunho, maior_arvore, maior_arvore * (sizeof(NoMCTS) + rascunho) / (1024.0 * 1024.0),
+           arena.capacidade);
+    printf("Partida: %llu blocos de filhos em %.3f s (%.0f alocacoes/s), %llu expansoes recusadas\n",
+           (unsigned long long)alocacoes, segundos, segundos > 0 ? alocacoes / segundos : 0.0,
+           (unsigned long long)arena.falhas);
+    comparar_alocacao(&arena, arena.capacidade - 1);
+    arena_destruir(&arena);
+}
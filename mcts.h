@@ -0,0 +1,80 @@
+/*
+    Busca em árvore Monte Carlo (MCTS/UCT) sobre uma arena de nós.
+
+    Os nós ficam em um único vetor alocado uma vez (a arena) e são reservados
+    por incremento de um contador, sem malloc por nó. Cada nó tem 32 bytes e
+    aponta para os filhos por um índice de 32 bits: os filhos de um nó são
+    reservados juntos, em um bloco contíguo. Como um bloco sempre é reservado
+    depois do nó pai, todo filho tem índice maior que o do pai.
+
+    - Entre partidas a árvore inteira é descartada em O(1) (o contador volta a zero).
+    - Entre jogadas, a subárvore da nova posição é reaproveitada por
+      compactação: os nós vivos deslizam para o início da arena, na mesma
+      ordem, e a nova raiz fica no índice 0.
+*/
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "motor.h"
+
+#define MCTS_EXPLORACAO 1.0 // Constante de exploração do UCB1
+
+// Estado de um nó
+enum { MCTS_ABERTO = 0, MCTS_VITORIA, MCTS_EMPATE }; // Vitória de quem jogou até o nó
+
+typedef struct {
+    uint64_t atual, mascara;  // Posição do nó (mesmo formato de Posicao)
+    uint32_t primeiro_filho;  // Índice do 1º filho na arena (0 = não expandido; o 0 é sempre a raiz)
+    uint32_t visitas;         // Partidas simuladas que passaram pelo nó
+    uint32_t pontos;          // 2 por vitória e 1 por empate de quem jogou até o nó
+    uint8_t num_filhos;
+    int8_t coluna;            // Jogada que levou a este nó (-1 na raiz)
+    uint8_t estado;
+    uint8_t jogadas;
+} NoMCTS;
+
+typedef struct {
+    NoMCTS* nos;
+    uint32_t capacidade;
+    uint32_t usados;          // Próximo índice livre
+    uint64_t* vivos;          // Rascunho da compactação: 1 bit por nó...
+    uint32_t* vivos_antes;    // ...e a contagem de vivos antes de cada palavra do mapa
+    uint64_t alocacoes;       // Blocos de filhos reservados desde a criação
+    uint64_t nos_alocados;
+    uint64_t falhas;          // Expansões recusadas por falta de espaço
+} ArenaMCTS;
+
+typedef struct {
+    int coluna;               // Filho mais visitado da raiz (-1 se não há jogadas)
+    double taxa_vitoria;      // Pontos médios dessa jogada (0 a 1)
+    int iteracoes;
+    uint32_t nos_arvore;      // Nós ocupados na arena ao final
+    uint32_t nos_reaproveitados; // Nós herdados da busca anterior pela compactação
+    uint64_t alocacoes;       // Blocos de filhos reservados nesta busca
+    double alocacoes_por_segundo;
+    double segundos;
+} ResultadoMCTS;
+
+// Reserva a arena com `megabytes` MB de nós (mais o rascunho da compactação)
+bool arena_criar(ArenaMCTS* arena, size_t megabytes);
+void arena_destruir(ArenaMCTS* arena);
+
+// Descarta todos os nós em O(1)
+void arena_limpar(ArenaMCTS* arena);
+
+// Reserva n nós consecutivos; retorna o índice do primeiro ou 0 se a arena estiver cheia
+uint32_t arena_alocar(ArenaMCTS* arena, uint32_t n);
+
+/*
+    Faz `iteracoes` ciclos de seleção, expansão, simulação (PLAYOUT_VIAS
+    partidas vetoriais por folha) e retropropagação a partir de p. Se p está
+    na árvore da busca anterior (até duas jogadas abaixo da raiz), essa
+    subárvore é compactada e reaproveitada; senão a arena é limpa.
+*/
+ResultadoMCTS mcts_buscar(ArenaMCTS* arena, const Posicao* p, int iteracoes, uint64_t semente);
+
+// Autojogo com reaproveitamento da árvore, medindo memória por nó e alocações por segundo contra malloc
+void benchmark_mcts(int iteracoes_por_jogada);
+
+#endif
@@ -0,0 +1,1013 @@
+/*
+    Motor de análise do Connect Four (Lig4).
+
+    Implementa as operações de bitboard, a avaliação estática e as
+    medições de desempenho usadas pela IA.
+*/
+
+#include "motor.h"
+#include "rede_neural.h"
+
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Máscaras das janelas de 4 casas, calculadas uma vez em motor_inicializar()
+static uint64_t mascaras_janelas[NUM_JANELAS];
+
+// Pontos de uma janela aberta conforme o número de peças de um único jogador
+static const int peso_por_contagem[5] = {0, 0, PESO_JANELA_DOIS, PESO_JANELA_TRES, 0};
+
+// Ordem de exploração das colunas: do centro para as bordas
+static int ordem_colunas[COLUNAS];
+
+// Casas da base de cada coluna e todas as casas jogáveis do tabuleiro
+static uint64_t mascara_base;
+static uint64_t mascara_tabuleiro;
+
+// Casas das linhas ímpares (1, 3, 5... contando da base a partir de 1), incluindo a sentinela quando ela cai numa linha ímpar
+static uint64_t mascara_linhas_impares;
+
+#if !defined(__GNUC__) && !defined(__clang__) && !defined(_MSC_VER)
+int contar_bits_portavel(uint64_t x) {
+    int n = 0;
+    while (x) {
+        x &= x - 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/*
+    Verifica 4 em linha deslocando o bitboard em cada direção:
+    1 = vertical, ALTURA = horizontal, ALTURA-1 e ALTURA+1 = diagonais.
+*/
+bool tem_alinhamento(uint64_t pecas) {
+    static const int direcoes[4] = {1, ALTURA, ALTURA - 1, ALTURA + 1};
+    for (int d = 0; d < 4; d++) {
+        uint64_t m = pecas & (pecas >> direcoes[d]);
+        if (m & (m >> (2 * direcoes[d]))) return true;
+    }
+    return false;
+}
+
+/*
+    Simula a jogada do jogador da vez e testa se ela fecha 4 em linha.
+*/
+bool jogada_vencedora(const Posicao* p, int coluna) {
+    uint64_t casa = (p->mascara + mascara_base_coluna(coluna)) & mascara_coluna(coluna);
+    return tem_alinhamento(p->atual | casa);
+}
+
+/*
+    Casas vazias onde uma peça completaria 4 em linha para o dono de `pecas`
+    (sem considerar se a casa já pode ser jogada).
+*/
+static uint64_t casas_vencedoras(uint64_t pecas, uint64_t mascara) {
+    // Vertical: três peças logo abaixo
+    uint64_t r = (pecas << 1) & (pecas << 2) & (pecas << 3);
+
+    // Horizontal e diagonais: casa no fim ou no meio de uma sequência de três
+    static const int direcoes[3] = {ALTURA, ALTURA - 1, ALTURA + 1};
+    for (int d = 0; d < 3; d++) {
+        int s = direcoes[d];
+        uint64_t q = (pecas << s) & (pecas << 2 * s);
+        r |= q & (pecas << 3 * s);
+        r |= q & (pecas >> s);
+        q = (pecas >> s) & (pecas >> 2 * s);
+        r |= q & (pecas << s);
+        r |= q & (pecas >> 3 * s);
+    }
+    return r & (mascara_tabuleiro ^ mascara);
+}
+
+/*
+    Análise de jogadas forçadas: vitórias imediatas, ameaças do adversário que
+    precisam ser bloqueadas e jogadas que colocariam a peça logo abaixo de uma
+    casa de vitória do adversário.
+*/
+JogadasForcadas analisar_jogadas_forcadas(const Posicao* p) {
+    JogadasForcadas f;
+    uint64_t possiveis = (p->mascara + mascara_base) & mascara_tabuleiro;
+    uint64_t ameacas = casas_vencedoras(pecas_adversario(p), p->mascara);
+
+    f.vitorias = possiveis & casas_vencedoras(p->atual, p->mascara);
+    f.bloqueios = possiveis & ameacas;
+    f.proibidas = possiveis & (ameacas >> 1);
+
+    uint64_t seguras = possiveis;
+    if (f.bloqueios) {
+        // Duas ameaças ao mesmo tempo não podem ser bloqueadas
+        seguras = (f.bloqueios & (f.bloqueios - 1)) ? 0 : f.bloqueios;
+    }
+    f.seguras = seguras & ~f.proibidas;
+    return f;
+}
+
+uint64_t jogadas_sem_derrota(const Posicao* p) {
+    return analisar_jogadas_forcadas(p).seguras;
+}
+
+/*
+    Argumento de "claimeven" descrito em motor.h. Testa primeiro as alturas
+    das colunas (uma operação), para ser barato nos nós em que não se aplica.
+*/
+static int resultado_paridade(const Posicao* p) {
+    // Próxima casa livre de cada coluna (sentinela se cheia) fora das linhas ímpares = alguma altura ímpar
+    uint64_t proximas = p->mascara + mascara_base;
+    if ((proximas & ~mascara_linhas_impares) != 0) return PARIDADE_INDEFINIDA;
+
+    // Distribuição final das casas vazias se o adversário responder sempre na mesma coluna
+    uint64_t vazias = mascara_tabuleiro & ~p->mascara;
+    uint64_t meu_final = p->atual | (vazias & mascara_linhas_impares);
+    uint64_t dele_final = pecas_adversario(p) | (vazias & ~mascara_linhas_impares);
+    if (tem_alinhamento(meu_final)) return PARIDADE_INDEFINIDA;
+    return tem_alinhamento(dele_final) ? PARIDADE_DERROTA : PARIDADE_SEM_VITORIA;
+}
+
+/*
+    Análise de paridade: classifica as ameaças de cada jogador pela linha e
+    diz se o argumento de paridade já decide a posição.
+*/
+AnaliseParidade analisar_paridade(const Posicao* p) {
+    AnaliseParidade a;
+    uint64_t ameacas_minhas = casas_vencedoras(p->atual, p->mascara);
+    uint64_t ameacas_deles = casas_vencedoras(pecas_adversario(p), p->mascara);
+    uint64_t impares = mascara_linhas_impares & mascara_tabuleiro;
+    a.ameacas_impares[0] = ameacas_minhas & impares;
+    a.ameacas_pares[0] = ameacas_minhas & ~impares;
+    a.ameacas_impares[1] = ameacas_deles & impares;
+    a.ameacas_pares[1] = ameacas_deles & ~impares;
+    a.resultado = resultado_paridade(p);
+    return a;
+}
+
+int coluna_da_jogada(uint64_t jogada) {
+    for (int c = 0; c < COLUNAS; c++) {
+        if (jogada & mascara_coluna(c)) return c;
+    }
+    return -1;
+}
+
+/*
+    Converte o tabuleiro da interface (linha 0 no topo, 0 = vazio, 1/2 = jogadores)
+    para o bitboard do motor, com jogador_vez como jogador da vez.
+*/
+Posicao posicao_de_tabuleiro(const int tabuleiro[LINHAS][COLUNAS], int jogador_vez) {
+    Posicao p = {0, 0, 0};
+    for (int j = 0; j < COLUNAS; j++) {
+        for (int i = 0; i < LINHAS; i++) {
+            int dono = tabuleiro[LINHAS - 1 - i][j];
+            if (dono == 0) continue;
+            uint64_t bit = UINT64_C(1) << (j * ALTURA + i);
+            p.mascara |= bit;
+            if (dono == jogador_vez) p.atual |= bit;
+            p.jogadas++;
+        }
+    }
+    return p;
+}
+
+/*
+    Gera as máscaras de todas as janelas de 4 casas (horizontais, verticais e
+    diagonais) que cabem no tabuleiro.
+*/
+static void inicializar_janelas(void) {
+    static const int passos[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}}; // {linha, coluna}
+    int n = 0;
+    for (int d = 0; d < 4; d++) {
+        for (int j = 0; j < COLUNAS; j++) {
+            for (int i = 0; i < LINHAS; i++) {
+                int i_fim = i + 3 * passos[d][0];
+                int j_fim = j + 3 * passos[d][1];
+                if (i_fim < 0 || i_fim >= LINHAS || j_fim >= COLUNAS) continue;
+                uint64_t janela = 0;
+                for (int k = 0; k < 4; k++) {
+                    janela |= UINT64_C(1) << ((j + k * passos[d][1]) * ALTURA + i + k * passos[d][0]);
+                }
+                mascaras_janelas[n++] = janela;
+            }
+        }
+    }
+    SDL_assert(n == NUM_JANELAS);
+}
+
+/*
+    Avaliação estática: para cada janela de 4 casas conta, com POPCNT, as peças
+    de cada jogador. Janelas com 2 ou 3 peças de um só jogador (e o resto vazio)
+    somam pontos para ele; janelas mistas não valem nada.
+*/
+static inline int avaliar_janelas(const Posicao* p) {
+    uint64_t meus = p->atual;
+    uint64_t deles = pecas_adversario(p);
+    int pontos = 0;
+    for (int w = 0; w < NUM_JANELAS; w++) {
+        int a = CONTAR_BITS(mascaras_janelas[w] & meus);
+        int b = CONTAR_BITS(mascaras_janelas[w] & deles);
+        pontos += peso_por_contagem[a] * (b == 0) - peso_por_contagem[b] * (a == 0);
+    }
+    return pontos;
+}
+
+static int avaliar_generico(const Posicao* p) {
+    return avaliar_janelas(p);
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+// Sem -mpopcnt o GCC troca __builtin_popcountll por uma rotina de software;
+// esta cópia usa a instrução POPCNT e é escolhida quando a CPU a tem
+__attribute__((target("popcnt")))
+static int avaliar_popcnt(const Posicao* p) {
+    return avaliar_janelas(p);
+}
+#define TEM_AVALIAR_POPCNT 1
+#endif
+
+static int (*avaliar_impl)(const Posicao* p) = avaliar_generico;
+
+int avaliar_posicao(const Posicao* p) {
+    return avaliar_impl(p);
+}
+
+void motor_inicializar(void) {
+    inicializar_janelas();
+#ifdef TEM_AVALIAR_POPCNT
+    if (SDL_HasSSE42()) avaliar_impl = avaliar_popcnt; // Toda CPU com SSE4.2 tem POPCNT
+#endif
+    mascara_base = 0;
+    mascara_tabuleiro = 0;
+    mascara_linhas_impares = 0;
+    for (int c = 0; c < COLUNAS; c++) {
+        mascara_base |= mascara_base_coluna(c);
+        mascara_tabuleiro |= mascara_coluna(c);
+        for (int l = 0; l < ALTURA; l += 2) mascara_linhas_impares |= mascara_base_coluna(c) << l;
+    }
+    for (int i = 0; i < COLUNAS; i++) {
+        // Alterna lados a partir do centro: 3, 2, 4, 1, 5, 0, 6
+        ordem_colunas[i] = COLUNAS / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+    }
+}
+
+/*
+    Mesma contagem de avaliar_posicao(), mas separando cada tipo de janela
+    para que o tunador possa ajustar os pesos.
+*/
+void caracteristicas_avaliacao(const Posicao* p, int caracteristicas[NUM_CARACTERISTICAS]) {
+    uint64_t meus = p->atual;
+    uint64_t deles = pecas_adversario(p);
+    int contagem[5] = {0};
+    for (int w = 0; w < NUM_JANELAS; w++) {
+        int a = CONTAR_BITS(mascaras_janelas[w] & meus);
+        int b = CONTAR_BITS(mascaras_janelas[w] & deles);
+        if (b == 0) contagem[a]++;
+        else if (a == 0) contagem[b]--;
+    }
+    caracteristicas[CARAC_JANELAS_DOIS] = contagem[2];
+    caracteristicas[CARAC_JANELAS_TRES] = contagem[3];
+}
+
+/*
+    Gera posições de meio-jogo com partidas aleatórias e mede quantas
+    avaliações estáticas por segundo a máquina consegue fazer.
+*/
+double benchmark_avaliacao(int num_posicoes, int repeticoes) {
+    Posicao* posicoes = malloc(sizeof(Posicao) * num_posicoes);
+    if (!posicoes) return 0.0;
+
+    for (int n = 0; n < num_posicoes; n++) {
+        Posicao p = {0, 0, 0};
+        int alvo = rand() % (TOTAL_CASAS - 8);
+        while (p.jogadas < alvo) {
+            int coluna = rand() % COLUNAS;
+            if (!pode_jogar(&p, coluna)) continue;
+            if (jogada_vencedora(&p, coluna)) break; // Para antes de a partida terminar
+            jogar_coluna(&p, coluna);
+        }
+        posicoes[n] = p;
+    }
+
+    volatile int soma = 0; // Impede que o compilador descarte as avaliações
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    for (int r = 0; r < repeticoes; r++) {
+        for (int n = 0; n < num_posicoes; n++) {
+            soma += avaliar_posicao(&posicoes[n]);
+        }
+    }
+    Uint64 fim = SDL_GetPerformanceCounter();
+    free(posicoes);
+
+    double segundos = (double)(fim - inicio) / (double)SDL_GetPerformanceFrequency();
+    double por_segundo = segundos > 0 ? (double)num_posicoes * repeticoes / segundos : 0.0;
+    printf("Avaliacao estatica: %d avaliacoes em %.3f s (%.0f aval/s)\n",
+           num_posicoes * repeticoes, segundos, por_segundo);
+    return por_segundo;
+}
+
+/*
+    Tabela de transposição. Larga: vetor de entradas endereçado pelos bits
+    altos de uma multiplicação da chave. Compacta: ver EntradaTTCompacta.
+    Nas duas, a entrada antiga é sempre substituída.
+*/
+#if COLUNAS > 15 || PONTUACAO_VITORIA >= (1 << 17)
+#error "Coluna ou pontuacao nao cabem na entrada compacta da tabela de transposicao"
+#endif
+
+static bool primo(uint64_t n) {
+    if (n < 2) return false;
+    for (uint64_t d = 2; d * d <= n; d++)
+        if (n % d == 0) return false;
+    return true;
+}
+
+bool tt_criar(TabelaTransposicao* tt, size_t megabytes) {
+    memset(tt, 0, sizeof(*tt));
+    uint64_t n = (uint64_t)megabytes * 1024 * 1024 / sizeof(EntradaTTCompacta);
+    while (n > 2 && !primo(n)) n--;
+    tt->compactas = calloc(n, sizeof(EntradaTTCompacta));
+    tt->num_entradas = tt->compactas ? n : 0;
+    // n * 2^TT_BITS_CHAVE >= 2^(ALTURA * COLUNAS)?
+    tt->sem_colisoes = ALTURA * COLUNAS <= TT_BITS_CHAVE ||
+                       (ALTURA * COLUNAS - TT_BITS_CHAVE < 64 && n >= (UINT64_C(1) << (ALTURA * COLUNAS - TT_BITS_CHAVE)));
+    return tt->compactas != NULL;
+}
+
+bool tt_criar_larga(TabelaTransposicao* tt, size_t megabytes) {
+    memset(tt, 0, sizeof(*tt));
+    uint64_t n = 1;
+    while (n * 2 * sizeof(EntradaTT) <= (uint64_t)megabytes * 1024 * 1024) n *= 2;
+    tt->entradas = calloc(n, sizeof(EntradaTT));
+    tt->num_entradas = tt->entradas ? n : 0;
+    tt->sem_colisoes = true;
+    return tt->entradas != NULL;
+}
+
+void tt_limpar(TabelaTransposicao* tt) {
+    if (tt->entradas) memset(tt->entradas, 0, tt->num_entradas * sizeof(EntradaTT));
+    if (tt->compactas) memset(tt->compactas, 0, tt->num_entradas * sizeof(EntradaTTCompacta));
+}
+
+void tt_destruir(TabelaTransposicao* tt) {
+    free(tt->entradas);
+    free(tt->compactas);
+    memset(tt, 0, sizeof(*tt));
+}
+
+// Conteúdo de uma entrada, no mesmo formato para as duas tabelas
+typedef struct {
+    int valor;
+    int profundidade;
+    int tipo;
+    int melhor;
+} DadosTT;
+
+enum { TT_AUSENTE, TT_ACERTO, TT_COLISAO };
+
+#define TT_MASCARA_CHAVE ((UINT64_C(1) << TT_BITS_CHAVE) - 1)
+
+static inline uint64_t tt_indice(const TabelaTransposicao* tt, uint64_t chave) {
+    if (tt->compactas) return chave % tt->num_entradas;
+    return (chave * UINT64_C(0x9E3779B97F4A7C15)) >> 32 & (tt->num_entradas - 1);
+}
+
+// Lê a entrada do índice; TT_ACERTO só se ela for da mesma posição
+static inline int tt_ler(const TabelaTransposicao* tt, uint64_t indice, uint64_t chave, DadosTT* d) {
+    if (tt->compactas) {
+        EntradaTTCompacta e = tt->compactas[indice];
+        if (e == 0) return TT_AUSENTE;
+        if ((e & TT_MASCARA_CHAVE) != (chave & TT_MASCARA_CHAVE)) return TT_COLISAO;
+        d->valor = (int)((int64_t)(e << (64 - TT_BITS_CHAVE - 18)) >> (64 - 18)); // Extensão de sinal dos 18 bits
+        d->profundidade = (int)(e >> 52 & 0x3F);
+        d->melhor = (int)(e >> 58 & 0xF) - 1;
+        d->tipo = (int)(e >> 62);
+        return TT_ACERTO;
+    }
+    const EntradaTT* e = &tt->entradas[indice];
+    if (e->tipo == TT_VAZIA) return TT_AUSENTE;
+    if (e->chave != chave) return TT_COLISAO;
+    d->valor = e->valor;
+    d->profundidade = e->profundidade;
+    d->melhor = e->melhor;
+    d->tipo = e->tipo;
+    return TT_ACERTO;
+}
+
+static inline void tt_gravar(TabelaTransposicao* tt, uint64_t indice, uint64_t chave, const DadosTT* d) {
+    if (tt->compactas) {
+        int profundidade = d->profundidade > 63 ? 63 : d->profundidade;
+        tt->compactas[indice] = (chave & TT_MASCARA_CHAVE) |
+                                ((uint64_t)(uint32_t)d->valor & 0x3FFFF) << TT_BITS_CHAVE |
+                                (uint64_t)profundidade << 52 |
+                                (uint64_t)(d->melhor + 1) << 58 |
+                                (uint64_t)d->tipo << 62;
+        return;
+    }
+    EntradaTT* e = &tt->entradas[indice];
+    e->chave = chave;
+    e->valor = d->valor;
+    e->profundidade = (int8_t)d->profundidade;
+    e->melhor = (int8_t)d->melhor;
+    e->tipo = (uint8_t)d->tipo;
+}
+
+// Rede usada nas folhas (NULL = avaliação manual); só é lida durante as buscas
+static const RedeNeural* rede_folhas = NULL;
+
+// Janelas de aspiração no aprofundamento iterativo
+static bool aspiracao_ativa = true;
+
+// Reduções de jogadas tardias e extensões de ameaça (desligadas por padrão, ver motor.h)
+static bool reducoes_ativas = false;
+static bool extensoes_ativas = false;
+
+void motor_usar_rede(const RedeNeural* rede) {
+    rede_folhas = rede;
+}
+
+// Estado compartilhado pelos nós de uma mesma busca
+typedef struct {
+    TabelaTransposicao* tt;
+    EstatisticasBusca* est;
+    const RedeNeural* rede;   // Rede das folhas (NULL = avaliação manual)
+    Acumulador acumulador;    // Camada oculta da posição atual, atualizada a cada jogada
+    Uint64 prazo;             // Valor de SDL_GetPerformanceCounter() em que a busca deve parar (0 = sem prazo)
+    SDL_atomic_t* parada;     // Pedido de parada de quem chamou a busca (NULL = só o prazo)
+    uint64_t proxima_checagem; // Contagem de nós da próxima verificação
+    bool pode_parar;          // Falso na 1ª iteração, que sempre termina
+    bool abortada;            // Prazo vencido ou parada pedida: os nós retornam sem valor
+    int profundidade_iteracao; // Profundidade da iteração atual (limita as extensões)
+    uint32_t historia[2][COLUNAS * ALTURA]; // Cortes por jogador e casa, ponderados pela profundidade
+} ContextoBusca;
+
+// Índice do bit da casa onde cairia a peça jogada na coluna
+static inline int casa_da_jogada(const Posicao* p, int coluna) {
+    return coluna * ALTURA + CONTAR_BITS(p->mascara & mascara_coluna(coluna));
+}
+
+// Depois da jogada, quem jogou ameaça vencer na próxima vez (o adversário é obrigado a bloquear)
+static inline bool criou_ameaca(const Posicao* filho) {
+    uint64_t jogaveis = (filho->mascara + mascara_base) & mascara_tabuleiro;
+    return (casas_vencedoras(pecas_adversario(filho), filho->mascara) & jogaveis) != 0;
+}
+
+// Joga/desfaz a peça da coluna no acumulador da rede, se ela estiver em uso
+static inline int rede_entrar(ContextoBusca* ctx, const Posicao* p, int coluna) {
+    if (!ctx->rede) return 0;
+    int casa = rede_casa_da_jogada(p, coluna);
+    rede_adicionar_peca(ctx->rede, &ctx->acumulador, p->jogadas % 2, casa);
+    return casa;
+}
+
+static inline void rede_sair(ContextoBusca* ctx, const Posicao* p, int casa) {
+    if (ctx->rede) rede_remover_peca(ctx->rede, &ctx->acumulador, p->jogadas % 2, casa);
+}
+
+// Lê o relógio e o pedido de parada; chamada só a cada NOS_ENTRE_CHECAGENS nós
+static void verificar_parada(ContextoBusca* ctx) {
+    ctx->proxima_checagem = ctx->est->nos + NOS_ENTRE_CHECAGENS;
+    ctx->est->checagens_relogio++;
+    if (!ctx->pode_parar) return;
+    if ((ctx->parada && SDL_AtomicGet(ctx->parada)) || (ctx->prazo && SDL_GetPerformanceCounter() >= ctx->prazo))
+        ctx->abortada = true;
+}
+
+/*
+    Negamax com poda alfa-beta. Retorna a pontuação da posição para o jogador
+    da vez, olhando até `profundidade` jogadas à frente.
+*/
+static int negamax(ContextoBusca* ctx, const Posicao* p, int profundidade, int alfa, int beta, int ply) {
+    EstatisticasBusca* est = ctx->est;
+    est->nos++;
+    if (ply > est->profundidade_seletiva) est->profundidade_seletiva = ply;
+    if (est->nos >= ctx->proxima_checagem) verificar_parada(ctx);
+    if (ctx->abortada) return 0; // Valor descartado pelo chamador
+
+    if (p->jogadas == TOTAL_CASAS) return 0; // Tabuleiro cheio: empate
+
+    // Vitória imediata dispensa qualquer busca; sem jogada segura, o adversário vence em seguida
+    JogadasForcadas forcadas = analisar_jogadas_forcadas(p);
+    if (forcadas.vitorias) return PONTUACAO_VITORIA - (p->jogadas + 1);
+    if (forcadas.seguras == 0) return -(PONTUACAO_VITORIA - (p->jogadas + 2));
+    uint64_t seguras = forcadas.seguras;
+
+    // Paridade das ameaças: derrota provada encerra o nó; "no máximo empate" limita beta
+    int paridade = resultado_paridade(p);
+    if (paridade == PARIDADE_DERROTA) {
+        est->cortes_paridade++;
+        return -PONTUACAO_MINIMA_VITORIA;
+    }
+    if (paridade == PARIDADE_SEM_VITORIA && beta > 0) {
+        beta = 0;
+        if (alfa >= beta) {
+            est->cortes_paridade++;
+            return beta;
+        }
+    }
+
+    if (profundidade <= 0) {
+        if (ctx->rede) return rede_avaliar(ctx->rede, &ctx->acumulador, p->jogadas % 2);
+        return avaliar_posicao(p);
+    }
+
+    // Consulta a tabela de transposição
+    uint64_t chave = p->atual + p->mascara;
+    uint64_t indice = 0;
+    int melhor_tt = -1;
+    if (ctx->tt) {
+        DadosTT d;
+        indice = tt_indice(ctx->tt, chave);
+        est->tt_consultas++;
+        int consulta = tt_ler(ctx->tt, indice, chave, &d);
+        if (consulta == TT_ACERTO) {
+            est->tt_acertos++;
+            melhor_tt = d.melhor;
+            if (d.profundidade >= profundidade) {
+                if (d.tipo == TT_EXATO) return d.valor;
+                if (d.tipo == TT_INFERIOR && d.valor >= beta) return d.valor;
+                if (d.tipo == TT_SUPERIOR && d.valor <= alfa) return d.valor;
+            }
+        } else if (consulta == TT_COLISAO) {
+            est->tt_colisoes++;
+        }
+    }
+
+    // Ordem das jogadas: melhor jogada da tabela primeiro, depois do centro para as bordas
+    int ordem[COLUNAS];
+    int n = 0;
+    if (melhor_tt >= 0 && (seguras & mascara_coluna(melhor_tt))) ordem[n++] = melhor_tt;
+    for (int i = 0; i < COLUNAS; i++) {
+        int c = ordem_colunas[i];
+        if (c != melhor_tt && (seguras & mascara_coluna(c))) ordem[n++] = c;
+    }
+
+    // Histórico médio das jogadas do nó, referência para decidir o que é "tardio e pouco promissor"
+    int lado = p->jogadas & 1;
+    // (nunca quando a profundidade já alcança o fim da partida, para que buscas até o fim continuem exatas)
+    bool pode_reduzir = reducoes_ativas && profundidade >= LMR_PROFUNDIDADE_MINIMA && n > LMR_JOGADAS_INTEGRAIS &&
+                        profundidade < TOTAL_CASAS - p->jogadas;
+    uint64_t soma_historia = 0;
+    if (pode_reduzir)
+        for (int i = 0; i < n; i++) soma_historia += ctx->historia[lado][casa_da_jogada(p, ordem[i])];
+
+    int alfa_original = alfa;
+    int melhor_valor = -PONTUACAO_INFINITA;
+    int melhor_coluna = -1;
+    for (int i = 0; i < n; i++) {
+        Posicao filho = *p;
+        int casa = rede_entrar(ctx, p, ordem[i]);
+        int bit = casa_da_jogada(p, ordem[i]);
+        jogar_coluna(&filho, ordem[i]);
+
+        // Extensão de sequências forçadas; redução de jogadas tardias sem histórico de cortes
+        int profundidade_filho = profundidade - 1;
+        bool ameaca = (reducoes_ativas || extensoes_ativas) && criou_ameaca(&filho);
+        if (ameaca && extensoes_ativas && ply < ctx->profundidade_iteracao) {
+            profundidade_filho++;
+            est->extensoes++;
+        }
+        int reducao = 0;
+        if (pode_reduzir && i >= LMR_JOGADAS_INTEGRAIS && !ameaca &&
+            (uint64_t)ctx->historia[lado][bit] * (uint64_t)n <= soma_historia)
+            reducao = profundidade >= LMR_PROFUNDIDADE_DUPLA ? 2 : 1;
+
+        int v;
+        if (reducao) {
+            est->reducoes++;
+            v = -negamax(ctx, &filho, profundidade_filho - reducao, -beta, -alfa, ply + 1);
+            if (v > alfa && !ctx->abortada) { // Resultado surpreendente: confirma na profundidade inteira
+                est->rebuscas++;
+                v = -negamax(ctx, &filho, profundidade_filho, -beta, -alfa, ply + 1);
+            }
+        } else {
+            v = -negamax(ctx, &filho, profundidade_filho, -beta, -alfa, ply + 1);
+        }
+        rede_sair(ctx, p, casa);
+        if (ctx->abortada) return 0; // Não guarda resultados incompletos na tabela
+        if (v > melhor_valor) {
+            melhor_valor = v;
+            melhor_coluna = ordem[i];
+        }
+        if (v > alfa) alfa = v;
+        if (alfa >= beta) {
+            est->cortes_beta++;
+            if (i == 0) est->cortes_primeira++;
+            uint32_t* h = &ctx->historia[lado][bit];
+            *h += (uint32_t)(profundidade * profundidade);
+            if (*h > (UINT32_C(1) << 30)) // Envelhece todo o histórico antes de estourar
+                for (int j = 0; j < COLUNAS * ALTURA; j++) {
+                    ctx->historia[0][j] >>= 1;
+                    ctx->historia[1][j] >>= 1;
+                }
+            break;
+        }
+    }
+
+    // Guarda o resultado na tabela de transposição
+    if (ctx->tt) {
+        DadosTT d;
+        d.valor = melhor_valor;
+        d.profundidade = profundidade;
+        d.melhor = melhor_coluna;
+        if (melhor_valor <= alfa_original) d.tipo = TT_SUPERIOR;
+        else if (melhor_valor >= beta) d.tipo = TT_INFERIOR;
+        else d.tipo = TT_EXATO;
+        tt_gravar(ctx->tt, indice, chave, &d);
+    }
+    return melhor_valor;
+}
+
+/*
+    Busca na raiz: percorre as jogadas legais e devolve a melhor coluna.
+*/
+static int buscar_raiz(ContextoBusca* ctx, const Posicao* p, int profundidade, int melhor_anterior,
+                       int alfa, int beta, int* pontuacao) {
+    // Só jogadas seguras; se todas perdem, busca todas para resistir o máximo possível
+    uint64_t candidatas = jogadas_sem_derrota(p);
+    if (candidatas == 0) candidatas = (p->mascara + mascara_base) & mascara_tabuleiro;
+
+    int ordem[COLUNAS];
+    int n = 0;
+    if (melhor_anterior >= 0 && (candidatas & mascara_coluna(melhor_anterior))) ordem[n++] = melhor_anterior;
+    for (int i = 0; i < COLUNAS; i++) {
+        int c = ordem_colunas[i];
+        if (c != melhor_anterior && (candidatas & mascara_coluna(c))) ordem[n++] = c;
+    }
+
+    // Fail-soft: fora da janela (alfa, beta) a pontuação devolvida é só um limite
+    int melhor_valor = -PONTUACAO_INFINITA - 1;
+    int melhor_coluna = -1;
+    ctx->est->nos++;
+    for (int i = 0; i < n; i++) {
+        Posicao filho = *p;
+        int casa = rede_entrar(ctx, p, ordem[i]);
+        jogar_coluna(&filho, ordem[i]);
+        int v = -negamax(ctx, &filho, profundidade - 1, -beta, -alfa, 1);
+        rede_sair(ctx, p, casa);
+        if (ctx->abortada) return -1;
+        if (v > melhor_valor) {
+            melhor_valor = v;
+            melhor_coluna = ordem[i];
+        }
+        if (v > alfa) alfa = v;
+        if (alfa >= beta) break;
+    }
+    *pontuacao = melhor_valor;
+    return melhor_coluna;
+}
+
+/*
+    Aprofundamento iterativo: busca com profundidade 1, 2, ... até
+    profundidade_max, reaproveitando a melhor jogada e a tabela de transposição
+    da iteração anterior. Para antes se encontrar uma vitória ou derrota forçada,
+    se o prazo vencer ou se a parada for pedida.
+*/
+ResultadoBusca buscar_jogada_com_prazo(const Posicao* p, int profundidade_max, double limite_ms, TabelaTransposicao* tt,
+                                       SDL_atomic_t* parada) {
+    ResultadoBusca r;
+    memset(&r, 0, sizeof(r));
+    r.coluna = -1;
+
+    EstatisticasBusca* est = &r.estatisticas;
+    ContextoBusca ctx;
+    ctx.tt = tt;
+    ctx.est = est;
+    ctx.rede = rede_folhas;
+    if (ctx.rede) rede_acumulador_inicial(ctx.rede, &ctx.acumulador, p);
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    ctx.parada = parada;
+    ctx.prazo = limite_ms > 0 ? inicio + (Uint64)(limite_ms * frequencia / 1000.0) : 0;
+    ctx.proxima_checagem = NOS_ENTRE_CHECAGENS;
+    ctx.pode_parar = false;
+    ctx.abortada = false;
+    ctx.profundidade_iteracao = 0;
+    memset(ctx.historia, 0, sizeof(ctx.historia));
+    uint64_t nos_anterior = 0;
+
+    // Posições táticas: vitória imediata ou uma única jogada segura dispensam a busca
+    JogadasForcadas forcadas = analisar_jogadas_forcadas(p);
+    if (forcadas.vitorias) {
+        r.coluna = coluna_da_jogada(forcadas.vitorias & -forcadas.vitorias);
+        r.pontuacao = PONTUACAO_VITORIA - (p->jogadas + 1);
+        r.forcada = true;
+        r.resolvida = true;
+        return r;
+    }
+    if (forcadas.seguras && (forcadas.seguras & (forcadas.seguras - 1)) == 0) {
+        Posicao filho = *p;
+        r.coluna = coluna_da_jogada(forcadas.seguras);
+        jogar_coluna(&filho, r.coluna);
+        r.pontuacao = -avaliar_posicao(&filho);
+        r.forcada = true;
+        return r;
+    }
+
+    int restantes = TOTAL_CASAS - p->jogadas;
+    if (profundidade_max > restantes) profundidade_max = restantes;
+
+    for (int d = 1; d <= profundidade_max; d++) {
+        uint64_t nos_antes = est->nos;
+        ctx.pode_parar = d > 1;
+        ctx.profundidade_iteracao = d;
+
+        // Janela de aspiração em torno da pontuação anterior (cheia na 1ª iteração e em resultados forçados)
+        int delta = JANELA_ASPIRACAO;
+        int alfa = -PONTUACAO_INFINITA, beta = PONTUACAO_INFINITA;
+        if (aspiracao_ativa && d > 1 && r.pontuacao > -PONTUACAO_MINIMA_VITORIA && r.pontuacao < PONTUACAO_MINIMA_VITORIA) {
+            alfa = r.pontuacao - delta;
+            beta = r.pontuacao + delta;
+        }
+
+        int pontuacao = 0;
+        int coluna = buscar_raiz(&ctx, p, d, r.coluna, alfa, beta, &pontuacao);
+        while (coluna >= 0 && ((pontuacao <= alfa && alfa > -PONTUACAO_INFINITA) ||
+                               (pontuacao >= beta && beta < PONTUACAO_INFINITA))) {
+            // Falhou fora da janela: alarga do lado que falhou e busca de novo
+            est->falhas_aspiracao++;
+            delta *= 4;
+            bool abrir = delta > JANELA_ASPIRACAO_MAXIMA || pontuacao <= -PONTUACAO_MINIMA_VITORIA ||
+                         pontuacao >= PONTUACAO_MINIMA_VITORIA;
+            if (pontuacao <= alfa) alfa = abrir ? -PONTUACAO_INFINITA : pontuacao - delta;
+            else beta = abrir ? PONTUACAO_INFINITA : pontuacao + delta;
+            coluna = buscar_raiz(&ctx, p, d, coluna, alfa, beta, &pontuacao);
+        }
+        if (coluna < 0) break;
+        r.coluna = coluna;
+        r.pontuacao = pontuacao;
+        est->profundidade = d;
+
+        uint64_t nos_iteracao = est->nos - nos_antes;
+        if (nos_anterior > 0) est->fator_ramificacao = (double)nos_iteracao / (double)nos_anterior;
+        nos_anterior = nos_iteracao;
+
+        // Resultado forçado encontrado, ou busca até o fim da partida: aprofundar não muda a jogada
+        if (pontuacao >= PONTUACAO_MINIMA_VITORIA || pontuacao <= -PONTUACAO_MINIMA_VITORIA || d == restantes) {
+            r.resolvida = true;
+            break;
+        }
+    }
+
+    Uint64 fim = SDL_GetPerformanceCounter();
+    est->interrompida = ctx.abortada;
+    if (ctx.prazo) est->atraso_ms = ((double)fim - (double)ctx.prazo) * 1000.0 / frequencia;
+    est->segundos = (double)(fim - inicio) / frequencia;
+    est->nos_por_segundo = est->segundos > 0 ? (double)est->nos / est->segundos : 0.0;
+    est->taxa_corte_primeira = est->cortes_beta ? (double)est->cortes_primeira / (double)est->cortes_beta : 0.0;
+    return r;
+}
+
+ResultadoBusca buscar_jogada(const Posicao* p, int profundidade_max, TabelaTransposicao* tt) {
+    return buscar_jogada_com_prazo(p, profundidade_max, 0, tt, NULL);
+}
+
+void motor_usar_reducoes(bool ativas) {
+    reducoes_ativas = ativas;
+}
+
+void motor_usar_extensoes(bool ativas) {
+    extensoes_ativas = ativas;
+}
+
+void motor_usar_aspiracao(bool ativa) {
+    aspiracao_ativa = ativa;
+}
+
+/*
+    Posições de teste (jogadas em colunas de 1 a 7, a partir do tabuleiro vazio)
+    usadas para comparar variações da busca sempre no mesmo conjunto.
+*/
+static const char* const posicoes_padrao[] = {
+    "", "4", "44", "43", "4453", "4444", "444333", "1234567", "7152", "7676",
+    "455735", "331567", "1552616533", "11717614242", "417415134673", "476215425516",
+    "341276217453", "7731717513422", "154113267761344", "541437267123635",
+};
+
+int num_posicoes_padrao(void) {
+    return (int)(sizeof(posicoes_padrao) / sizeof(posicoes_padrao[0]));
+}
+
+bool posicao_padrao(int indice, Posicao* p) {
+    p->atual = p->mascara = 0;
+    p->jogadas = 0;
+    if (indice < 0 || indice >= num_posicoes_padrao()) return false;
+    for (const char* c = posicoes_padrao[indice]; *c; c++) {
+        int coluna = *c - '1';
+        if (coluna < 0 || coluna >= COLUNAS || !pode_jogar(p, coluna) || jogada_vencedora(p, coluna)) return false;
+        jogar_coluna(p, coluna);
+    }
+    return true;
+}
+
+/*
+    Compara o total de nós com e sem janelas de aspiração no conjunto de
+    posições padrão, com a tabela de transposição limpa antes de cada busca.
+*/
+void benchmark_aspiracao(int profundidade, TabelaTransposicao* tt) {
+    bool original = aspiracao_ativa;
+    uint64_t total[2] = {0, 0};
+    double tempo[2] = {0, 0};
+
+    printf("%-16s %12s %12s %8s\n", "posicao", "janela cheia", "aspiracao", "refeitas");
+    for (int i = 0; i < num_posicoes_padrao(); i++) {
+        Posicao p;
+        if (!posicao_padrao(i, &p)) continue;
+        ResultadoBusca r[2];
+        for (int modo = 0; modo < 2; modo++) {
+            aspiracao_ativa = modo == 1;
+            if (tt) tt_limpar(tt);
+            r[modo] = buscar_jogada(&p, profundidade, tt);
+            total[modo] += r[modo].estatisticas.nos;
+            tempo[modo] += r[modo].estatisticas.segundos;
+        }
+        printf("%-16s %12llu %12llu %8llu\n", posicoes_padrao[i][0] ? posicoes_padrao[i] : "(vazio)",
+               (unsigned long long)r[0].estatisticas.nos, (unsigned long long)r[1].estatisticas.nos,
+               (unsigned long long)r[1].estatisticas.falhas_aspiracao);
+    }
+    printf("Total: janela cheia %llu nos (%.2f s), aspiracao %llu nos (%.2f s), %.1f%% dos nos\n",
+           (unsigned long long)total[0], tempo[0], (unsigned long long)total[1], tempo[1],
+           total[0] ? 100.0 * (double)total[1] / (double)total[0] : 0.0);
+    aspiracao_ativa = original;
+}
+
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+    Busca cada posição padrão sem limite de profundidade até o prazo e mede
+    quanto depois do prazo a busca realmente retornou.
+*/
+void benchmark_prazo(double limite_ms, TabelaTransposicao* tt) {
+    double atrasos[64];
+    int n = 0;
+    for (int i = 0; i < num_posicoes_padrao() && n < 64; i++) {
+        Posicao p;
+        if (!posicao_padrao(i, &p)) continue;
+        if (tt) tt_limpar(tt);
+        ResultadoBusca r = buscar_jogada_com_prazo(&p, TOTAL_CASAS, limite_ms, tt, NULL);
+        const EstatisticasBusca* e = &r.estatisticas;
+        printf("%-16s prof %2d %10llu nos %8.2f ms %s atraso %+.3f ms\n",
+               posicoes_padrao[i][0] ? posicoes_padrao[i] : "(vazio)", e->profundidade,
+               (unsigned long long)e->nos, e->segundos * 1000.0, e->interrompida ? "interrompida" : "completa    ",
+               e->atraso_ms);
+        if (e->interrompida) atrasos[n++] = e->atraso_ms;
+    }
+    if (n == 0) {
+        printf("Nenhuma busca chegou ao prazo de %.1f ms\n", limite_ms);
+        return;
+    }
+    qsort(atrasos, (size_t)n, sizeof(double), comparar_double);
+    double soma = 0;
+    for (int i = 0; i < n; i++) soma += atrasos[i];
+    printf("Prazo %.1f ms, %d buscas interrompidas: atraso medio %.3f ms, p99 %.3f ms, maximo %.3f ms\n",
+           limite_ms, n, soma / n, atrasos[(n * 99) / 100], atrasos[n - 1]);
+}
+
+/*
+    Resolve até o fim as posições padrão com 12 jogadas ou mais, com tabelas
+    compacta e larga do mesmo tamanho em memória, e compara entradas por MB,
+    nós e tempo. As duas devem dar a mesma pontuação.
+*/
+void benchmark_tt(void) {
+    static const size_t tamanhos_mb[] = {1, 4, 16};
+    for (size_t t = 0; t < sizeof(tamanhos_mb) / sizeof(tamanhos_mb[0]); t++) {
+        TabelaTransposicao tabelas[2];
+        if (!tt_criar(&tabelas[0], tamanhos_mb[t]) || !tt_criar_larga(&tabelas[1], tamanhos_mb[t])) {
+            printf("Sem memoria para as tabelas de %zu MB\n", tamanhos_mb[t]);
+            tt_destruir(&tabelas[0]);
+            tt_destruir(&tabelas[1]);
+            return;
+        }
+        printf("%zu MB: compacta %llu entradas (%s), larga %llu entradas\n", tamanhos_mb[t],
+               (unsigned long long)tabelas[0].num_entradas, tabelas[0].sem_colisoes ? "sem colisoes" : "com colisoes",
+               (unsigned long long)tabelas[1].num_entradas);
+        printf("  %-16s %12s %9s %12s %9s\n", "posicao", "nos compacta", "s", "nos larga", "s");
+        uint64_t nos[2] = {0, 0};
+        double tempo[2] = {0, 0};
+        int divergencias = 0;
+        for (int i = 0; i < num_posicoes_padrao(); i++) {
+            Posicao p;
+            if (strlen(posicoes_padrao[i]) < 12 || !posicao_padrao(i, &p)) continue;
+            ResultadoBusca r[2];
+            for (int modo = 0; modo < 2; modo++) {
+                tt_limpar(&tabelas[modo]);
+                r[modo] = buscar_jogada(&p, TOTAL_CASAS - p.jogadas, &tabelas[modo]);
+                nos[modo] += r[modo].estatisticas.nos;
+                tempo[modo] += r[modo].estatisticas.segundos;
+            }
+            if (r[0].pontuacao != r[1].pontuacao) divergencias++;
+            printf("  %-16s %12llu %9.3f %12llu %9.3f%s\n", posicoes_padrao[i],
+                   (unsigned long long)r[0].estatisticas.nos, r[0].estatisticas.segundos,
+                   (unsigned long long)r[1].estatisticas.nos, r[1].estatisticas.segundos,
+                   r[0].pontuacao != r[1].pontuacao ? "  DIVERGE" : "");
+        }
+        printf("  Total: compacta %llu nos em %.3f s, larga %llu nos em %.3f s (%.2fx), %d divergencias\n",
+               (unsigned long long)nos[0], tempo[0], (unsigned long long)nos[1], tempo[1],
+               tempo[0] > 0 ? tempo[1] / tempo[0] : 0.0, divergencias);
+        tt_destruir(&tabelas[0]);
+        tt_destruir(&tabelas[1]);
+    }
+}
+
+/*
+    Partidas com prazo fixo por jogada entre o motor com as reduções e/ou
+    extensões pedidas (A) e sem nenhuma delas (B). Cada abertura aleatória de 4 jogadas é jogada duas
+    vezes, trocando as cores; cada motor tem a própria tabela de transposição.
+*/
+void benchmark_reducoes(int partidas, double limite_ms, bool reduzir, bool estender) {
+    TabelaTransposicao tabelas[2];
+    if (!tt_criar(&tabelas[0], 16) || !tt_criar(&tabelas[1], 16)) {
+        printf("Sem memoria para as tabelas de transposicao\n");
+        tt_destruir(&tabelas[0]);
+        return;
+    }
+    bool reducoes_originais = reducoes_ativas, extensoes_originais = extensoes_ativas;
+    int vitorias = 0, empates = 0, derrotas = 0;
+    uint64_t soma_profundidade[2] = {0, 0}, jogadas_busca[2] = {0, 0};
+    uint64_t rng = UINT64_C(0x2545F4914F6CDD1D);
+    Posicao abertura = {0, 0, 0};
+
+    for (int g = 0; g < partidas; g++) {
+        // Nova abertura a cada par de partidas (só jogadas que não vencem nem entregam a vitória)
+        if (g % 2 == 0) {
+            do {
+                abertura = (Posicao){0, 0, 0};
+                for (int k = 0; k < 4; k++) {
+                    uint64_t seguras = jogadas_sem_derrota(&abertura);
+                    if (!seguras) break;
+                    int c;
+                    do {
+                        rng ^= rng << 13;
+                        rng ^= rng >> 7;
+                        rng ^= rng << 17;
+                        c = (int)(rng % COLUNAS);
+                    } while (!(seguras & mascara_coluna(c)));
+                    jogar_coluna(&abertura, c);
+                }
+            } while (abertura.jogadas < 4 || analisar_jogadas_forcadas(&abertura).vitorias);
+        }
+        int cor_a = g % 2; // Paridade das jogadas do motor A
+        tt_limpar(&tabelas[0]);
+        tt_limpar(&tabelas[1]);
+
+        Posicao p = abertura;
+        int vencedor = -1; // -1 = empate, senão o motor (0 = A, 1 = B)
+        while (p.jogadas < TOTAL_CASAS) {
+            int motor = (p.jogadas % 2 == cor_a) ? 0 : 1;
+            reducoes_ativas = motor == 0 && reduzir;
+            extensoes_ativas = motor == 0 && estender;
+            ResultadoBusca r = buscar_jogada_com_prazo(&p, TOTAL_CASAS, limite_ms, &tabelas[motor], NULL);
+            if (!r.forcada) {
+                soma_profundidade[motor] += (uint64_t)r.estatisticas.profundidade;
+                jogadas_busca[motor]++;
+            }
+            if (jogada_vencedora(&p, r.coluna)) {
+                vencedor = motor;
+                break;
+            }
+            jogar_coluna(&p, r.coluna);
+        }
+        if (vencedor == 0) vitorias++;
+        else if (vencedor == 1) derrotas++;
+        else empates++;
+        printf("\rpartida %d/%d: +%d =%d -%d", g + 1, partidas, vitorias, empates, derrotas);
+        fflush(stdout);
+    }
+    reducoes_ativas = reducoes_originais;
+    extensoes_ativas = extensoes_originais;
+    tt_destruir(&tabelas[0]);
+    tt_destruir(&tabelas[1]);
+
+    // Elo pela pontuação média, com erro padrão aproximado pela variância dos resultados
+    double n = (double)partidas;
+    double pontos = (vitorias + 0.5 * empates) / n;
+    double variancia = (vitorias * (1 - pontos) * (1 - pontos) + empates * (0.5 - pontos) * (0.5 - pontos) +
+                        derrotas * pontos * pontos) / n;
+    double erro = sqrt(variancia / n);
+    double p_min = pontos - 2 * erro, p_max = pontos + 2 * erro;
+#define ELO(x) ((x) <= 0 ? -999.0 : (x) >= 1 ? 999.0 : -400.0 * log10(1.0 / (x) - 1.0))
+    printf("\nCom %s contra sem, %.0f ms por jogada: +%d =%d -%d (%.1f%%), Elo %+.0f [%+.0f, %+.0f]\n",
+           reduzir && estender ? "reducoes e extensoes" : reduzir ? "reducoes" : "extensoes", limite_ms, vitorias, empates, derrotas, 100.0 * pontos, ELO(pontos), ELO(p_min), ELO(p_max));
+#undef ELO
+    printf("Profundidade media: com %.2f, sem %.2f\n",
+           jogadas_busca[0] ? (double)soma_profundidade[0] / jogadas_busca[0] : 0.0,
+           jogadas_busca[1] ? (double)soma_profundidade[1] / jogadas_busca[1] : 0.0);
+}
+
+void registrar_estatisticas(const EstatisticasBusca* e) {
+    SDL_Log("busca: prof %d/%d nos %llu (%.0f nos/s, %.1f ms) tt %llu/%llu acertos %llu colisoes "
+            "cortes %llu (%.1f%% na 1a jogada) paridade %llu aspiracao refeitas %llu ramificacao %.2f "
+            "reducoes %llu (%llu refeitas) extensoes %llu",
+            e->profundidade, e->profundidade_seletiva,
+            (unsigned long long)e->nos, e->nos_por_segundo, e->segundos * 1000.0,
+            (unsigned long long)e->tt_acertos, (unsigned long long)e->tt_consultas,
+            (unsigned long long)e->tt_colisoes,
+            (unsigned long long)e->cortes_beta, e->taxa_corte_primeira * 100.0,
+            (unsigned long long)e->cortes_paridade, (unsigned long long)e->falhas_aspiracao,
+            e->fator_ramificacao, (unsigned long long)e->reducoes, (unsigned long long)e->rebuscas,
+            (unsigned long long)e->extensoes);
+    if (e->interrompida) SDL_Log("busca: interrompida, %.3f ms depois do prazo", e->atraso_ms);
+}
@@ -0,0 +1,344 @@
+/*
+    Motor de análise do Connect Four (Lig4).
+
+    Representa o tabuleiro com bitboards de 64 bits para que a IA consiga
+    avaliar e jogar posições sem percorrer casa por casa.
+
+    Layout dos bits: cada coluna ocupa ALTURA = LINHAS + 1 bits consecutivos,
+    da base (bit 0 da coluna) para o topo. O bit extra de cada coluna fica
+    sempre vazio e serve de "sentinela" para que os deslocamentos usados na
+    detecção de alinhamentos não passem de uma coluna para a outra.
+*/
+
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <SDL2/SDL_atomic.h> // SDL_atomic_t do pedido de parada da busca
+
+#ifndef LINHAS
+#define LINHAS 6     // Número de linhas do tabuleiro
+#endif
+#ifndef COLUNAS
+#define COLUNAS 7    // Número de colunas do tabuleiro
+#endif
+
+#define ALTURA (LINHAS + 1)            // Bits por coluna (inclui a sentinela)
+#define TOTAL_CASAS (LINHAS * COLUNAS) // Número de casas jogáveis
+
+#if ALTURA * COLUNAS > 64
+#error "O tabuleiro não cabe em um bitboard de 64 bits"
+#endif
+
+// Contagem de bits em hardware (POPCNT) quando o compilador oferece
+#if defined(__GNUC__) || defined(__clang__)
+#define CONTAR_BITS(x) __builtin_popcountll(x)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define CONTAR_BITS(x) ((int)__popcnt64(x))
+#else
+int contar_bits_portavel(uint64_t x);
+#define CONTAR_BITS(x) contar_bits_portavel(x)
+#endif
+
+/*
+    Posição do jogo em forma de bitboard.
+    atual:   peças do jogador que está na vez
+    mascara: todas as peças do tabuleiro
+    jogadas: número de peças já jogadas (o jogador 1 joga nas jogadas pares)
+*/
+typedef struct {
+    uint64_t atual;
+    uint64_t mascara;
+    int jogadas;
+} Posicao;
+
+// Bit da casa mais baixa de uma coluna
+static inline uint64_t mascara_base_coluna(int coluna) {
+    return UINT64_C(1) << (coluna * ALTURA);
+}
+
+// Bit da casa mais alta (jogável) de uma coluna
+static inline uint64_t mascara_topo_coluna(int coluna) {
+    return UINT64_C(1) << (LINHAS - 1 + coluna * ALTURA);
+}
+
+// Todos os bits jogáveis de uma coluna
+static inline uint64_t mascara_coluna(int coluna) {
+    return ((UINT64_C(1) << LINHAS) - 1) << (coluna * ALTURA);
+}
+
+// Retorna true se ainda cabe peça na coluna
+static inline bool pode_jogar(const Posicao* p, int coluna) {
+    return (p->mascara & mascara_topo_coluna(coluna)) == 0;
+}
+
+// Joga uma peça do jogador da vez na coluna (a coluna deve estar livre)
+static inline void jogar_coluna(Posicao* p, int coluna) {
+    p->atual ^= p->mascara;
+    p->mascara |= p->mascara + mascara_base_coluna(coluna);
+    p->jogadas++;
+}
+
+// Peças do adversário do jogador da vez
+static inline uint64_t pecas_adversario(const Posicao* p) {
+    return p->atual ^ p->mascara;
+}
+
+// Retorna true se as peças do bitboard formam 4 em linha
+bool tem_alinhamento(uint64_t pecas);
+
+// Retorna true se o jogador da vez vence jogando na coluna
+bool jogada_vencedora(const Posicao* p, int coluna);
+
+/*
+    Jogadas forçadas (análise sem busca)
+    Cada campo é um bitboard com a casa onde a peça cairia em cada coluna.
+*/
+typedef struct {
+    uint64_t vitorias;   // Jogadas que vencem imediatamente
+    uint64_t bloqueios;  // Casas onde o adversário venceria na próxima jogada
+    uint64_t proibidas;  // Jogadas que liberam a casa de vitória do adversário logo acima
+    uint64_t seguras;    // Jogadas que não entregam a vitória ao adversário na jogada seguinte
+} JogadasForcadas;
+
+JogadasForcadas analisar_jogadas_forcadas(const Posicao* p);
+
+// Atalho para o campo `seguras`: 0 significa que toda jogada perde em seguida
+uint64_t jogadas_sem_derrota(const Posicao* p);
+
+// Coluna de um bitboard com uma única jogada (-1 se vazio)
+int coluna_da_jogada(uint64_t jogada);
+
+/*
+    Paridade das ameaças (zugzwang)
+    Linhas contadas a partir de 1 na base: ameaças em linhas ímpares favorecem
+    quem começou a partida, em linhas pares favorecem o segundo jogador.
+
+    A análise é conclusiva quando todas as colunas têm altura par: o jogador
+    que NÃO está na vez pode responder sempre na mesma coluna ("claimeven") e
+    fica com todas as casas vazias de linhas pares, deixando as ímpares ao
+    adversário. Se nem assim o jogador da vez completa 4 em linha, ele não
+    vence; se além disso o outro completa, o outro vence.
+*/
+enum {
+    PARIDADE_INDEFINIDA,     // Argumento de paridade não se aplica ou não decide
+    PARIDADE_SEM_VITORIA,    // O jogador da vez não pode vencer (no máximo empata)
+    PARIDADE_DERROTA         // O jogador da vez perde
+};
+
+typedef struct {
+    uint64_t ameacas_impares[2]; // [0] = jogador da vez, [1] = adversário
+    uint64_t ameacas_pares[2];
+    int resultado;               // PARIDADE_*
+} AnaliseParidade;
+
+AnaliseParidade analisar_paridade(const Posicao* p);
+
+// Monta a posição a partir do tabuleiro da interface (linha 0 = topo)
+Posicao posicao_de_tabuleiro(const int tabuleiro[LINHAS][COLUNAS], int jogador_vez);
+
+/*
+    Avaliação estática
+*/
+
+// Janelas de 4 casas alinhadas (69 no tabuleiro 7x6)
+#define NUM_JANELAS ((COLUNAS - 3) * LINHAS + (LINHAS - 3) * COLUNAS + \
+                     2 * (COLUNAS - 3) * (LINHAS - 3))
+
+/*
+    Pesos da avaliação, ajustados pelo tunador (PESO_JANELA_DOIS e
+    PESO_JANELA_TRES). São inteiros em frações de 1/ESCALA_PESOS de ponto,
+    para a proporção ajustada entre eles não se perder no arredondamento;
+    a avaliação sai na mesma escala.
+*/
+#define ESCALA_PESOS 8
+#include "pesos_avaliacao.h"
+
+// Características que a avaliação combina linearmente com os pesos acima
+enum {
+    CARAC_JANELAS_DOIS,  // Janelas abertas com 2 peças: do jogador da vez menos as do adversário
+    CARAC_JANELAS_TRES,  // O mesmo para janelas com 3 peças
+    NUM_CARACTERISTICAS
+};
+
+// Prepara as tabelas do motor (deve ser chamada uma vez no início)
+void motor_inicializar(void);
+
+// Pontua a posição para o jogador da vez (positivo = vantagem dele)
+int avaliar_posicao(const Posicao* p);
+
+// Extrai as características da posição: avaliar_posicao() = soma de peso * característica
+void caracteristicas_avaliacao(const Posicao* p, int caracteristicas[NUM_CARACTERISTICAS]);
+
+// Mede a velocidade da avaliação estática (avaliações por segundo)
+double benchmark_avaliacao(int num_posicoes, int repeticoes);
+
+/*
+    Tabela de transposição
+*/
+
+// Tipos de limite guardados na tabela (TT_VAZIA marca entrada livre)
+enum { TT_VAZIA = 0, TT_EXATO, TT_INFERIOR, TT_SUPERIOR };
+
+// Entrada larga (16 bytes), com a chave inteira
+typedef struct {
+    uint64_t chave;       // Chave completa da posição (atual + mascara)
+    int32_t valor;        // Pontuação para o jogador da vez
+    int8_t profundidade;  // Profundidade restante com que foi buscada
+    uint8_t tipo;         // TT_EXATO, TT_INFERIOR ou TT_SUPERIOR
+    int8_t melhor;        // Melhor coluna encontrada (-1 se nenhuma)
+} EntradaTT;
+
+/*
+    Entrada compacta (8 bytes). A tabela tem um número primo de entradas e a
+    posição vai para o índice chave % num_entradas; a entrada guarda só os
+    TT_BITS_CHAVE bits baixos da chave. Pelo teorema chinês do resto, índice
+    e bits guardados identificam a chave sem ambiguidade quando
+    num_entradas * 2^TT_BITS_CHAVE >= 2^(ALTURA * COLUNAS) (no 7x6, a partir
+    de 2^15 entradas, ou 256 KB).
+      bits  0..33  chave truncada
+      bits 34..51  valor (18 bits com sinal)
+      bits 52..57  profundidade (6 bits)
+      bits 58..61  melhor coluna + 1 (4 bits)
+      bits 62..63  tipo (TT_VAZIA = entrada livre)
+*/
+typedef uint64_t EntradaTTCompacta;
+#define TT_BITS_CHAVE 34
+
+typedef struct {
+    EntradaTT* entradas;           // Formato largo (NULL numa tabela compacta)
+    EntradaTTCompacta* compactas;  // Formato compacto (NULL numa tabela larga)
+    uint64_t num_entradas;         // Potência de 2 na tabela larga, primo na compacta
+    bool sem_colisoes;             // Índice + chave truncada identificam a posição (sempre verdadeiro na larga)
+} TabelaTransposicao;
+
+// Aloca uma tabela compacta com até `megabytes` MB; retorna false se faltar memória
+bool tt_criar(TabelaTransposicao* tt, size_t megabytes);
+// Mesma coisa com entradas largas (para comparação)
+bool tt_criar_larga(TabelaTransposicao* tt, size_t megabytes);
+void tt_limpar(TabelaTransposicao* tt);
+void tt_destruir(TabelaTransposicao* tt);
+
+// Compara entradas por MB e tempo para resolver posições padrão com tabelas compacta e larga de mesma memória
+void benchmark_tt(void);
+
+/*
+    Busca
+*/
+
+// Vitória vale PONTUACAO_VITORIA menos o número de peças no fim (vencer cedo vale mais)
+#define PONTUACAO_VITORIA 100000
+#define PONTUACAO_INFINITA 1000000
+// Menor pontuação possível de uma vitória forçada
+#define PONTUACAO_MINIMA_VITORIA (PONTUACAO_VITORIA - TOTAL_CASAS)
+
+// Números coletados durante uma busca, para ajuste de memória e tempo da IA
+typedef struct {
+    uint64_t nos;                  // Posições visitadas
+    double segundos;               // Duração da busca
+    double nos_por_segundo;
+    int profundidade;              // Última iteração completa
+    int profundidade_seletiva;     // Maior distância da raiz realmente visitada
+    uint64_t tt_consultas;         // Consultas à tabela de transposição
+    uint64_t tt_acertos;           // Consultas que encontraram a posição
+    uint64_t tt_colisoes;          // Consultas que acharam outra posição na entrada
+    uint64_t cortes_beta;          // Nós encerrados por corte beta
+    uint64_t cortes_primeira;      // Cortes produzidos já pela primeira jogada
+    double taxa_corte_primeira;    // cortes_primeira / cortes_beta
+    uint64_t cortes_paridade;      // Nós resolvidos pela análise de paridade, sem busca
+    uint64_t falhas_aspiracao;     // Buscas refeitas por falha fora da janela de aspiração
+    double fator_ramificacao;      // Nós da última iteração / nós da anterior
+    uint64_t reducoes;             // Jogadas tardias buscadas com profundidade reduzida
+    uint64_t rebuscas;             // Reduções que surpreenderam (passaram de alfa) e foram refeitas inteiras
+    uint64_t extensoes;            // Jogadas que criaram ameaça imediata e ganharam uma jogada de profundidade
+    uint64_t checagens_relogio;    // Vezes em que o prazo e o pedido de parada foram verificados
+    bool interrompida;             // Busca cortada pelo prazo ou pelo pedido de parada
+    double atraso_ms;              // Tempo além do prazo ao retornar (negativo = terminou antes)
+} EstatisticasBusca;
+
+typedef struct {
+    int coluna;                    // Melhor coluna (-1 se não há jogadas)
+    int pontuacao;                 // Pontuação da melhor coluna para o jogador da vez
+    bool forcada;                  // Jogada decidida pela análise de jogadas forçadas, sem busca
+    bool resolvida;                // Pontuação provada (vitória/derrota forçada ou busca até o fim da partida)
+    EstatisticasBusca estatisticas;
+} ResultadoBusca;
+
+// Nós visitados entre duas verificações do relógio e do pedido de parada (~0,4 ms a 2,4M nós/s)
+#define NOS_ENTRE_CHECAGENS 1024
+
+// Janela de aspiração inicial (em pontos da avaliação) e largura a partir da qual ela é aberta
+#define JANELA_ASPIRACAO (8 * ESCALA_PESOS)
+#define JANELA_ASPIRACAO_MAXIMA (512 * ESCALA_PESOS)
+
+// Liga/desliga as janelas de aspiração (ligadas por padrão)
+void motor_usar_aspiracao(bool ativa);
+
+/*
+    Reduções de jogadas tardias: a partir da LMR_JOGADAS_INTEGRAIS-ésima
+    jogada de um nó com profundidade >= LMR_PROFUNDIDADE_MINIMA, jogadas com
+    histórico de cortes abaixo da média do nó são buscadas com uma jogada a
+    menos (duas a partir de LMR_PROFUNDIDADE_DUPLA) e refeitas inteiras se
+    passarem de alfa. Jogadas que criam ameaça imediata nunca são reduzidas;
+    com as extensões ligadas, ganham uma jogada de profundidade.
+    As duas vêm desligadas: em autojogo com prazo fixo (benchmark_reducoes)
+    as reduções ganham ~0,7 jogada de profundidade sem ganho de força
+    mensurável, e as extensões perdem força.
+*/
+#define LMR_JOGADAS_INTEGRAIS 3
+#define LMR_PROFUNDIDADE_MINIMA 3
+#define LMR_PROFUNDIDADE_DUPLA 7
+
+// Liga/desliga as reduções de jogadas tardias e as extensões de ameaça
+void motor_usar_reducoes(bool ativas);
+void motor_usar_extensoes(bool ativas);
+
+// Rede neural opcional usada nas folhas da busca (definida em rede_neural.h)
+typedef struct RedeNeural RedeNeural;
+
+// Passa a avaliar as folhas com a rede (NULL volta à avaliação manual)
+void motor_usar_rede(const RedeNeural* rede);
+
+/*
+    Busca alfa-beta (negamax) com aprofundamento iterativo até profundidade_max.
+    Se a análise de jogadas forçadas já decide a jogada, nenhuma busca é feita.
+    tt pode ser NULL para buscar sem tabela de transposição.
+*/
+ResultadoBusca buscar_jogada(const Posicao* p, int profundidade_max, TabelaTransposicao* tt);
+
+/*
+    Igual a buscar_jogada(), mas para após limite_ms milissegundos (0 = sem
+    prazo) ou quando `parada` (se não for NULL) passar a valer 1, o que pode
+    ser feito de outra thread. Cada busca tem o seu pedido: quem chama zera
+    o flag antes de começar (antes de criar a thread da busca) e a busca
+    nunca o zera, para um pedido feito antes de ela começar não se perder.
+    O relógio e o pedido só são lidos a cada NOS_ENTRE_CHECAGENS nós.
+    A iteração interrompida é descartada e vale a última completa; a
+    profundidade 1 nunca é interrompida, para sempre haver uma jogada.
+*/
+ResultadoBusca buscar_jogada_com_prazo(const Posicao* p, int profundidade_max, double limite_ms, TabelaTransposicao* tt,
+                                       SDL_atomic_t* parada);
+
+/*
+    Conjunto fixo de posições para comparar variações da busca.
+    posicao_padrao() devolve false se o índice for inválido.
+*/
+int num_posicoes_padrao(void);
+bool posicao_padrao(int indice, Posicao* p);
+
+// Compara o total de nós com e sem janelas de aspiração nas posições padrão
+void benchmark_aspiracao(int profundidade, TabelaTransposicao* tt);
+
+// Mede o atraso em relação ao prazo (médio, p99 e máximo) nas posições padrão
+void benchmark_prazo(double limite_ms, TabelaTransposicao* tt);
+
+// Partidas de autojogo com prazo fixo por jogada: motor com as reduções e/ou extensões pedidas contra o motor sem elas
+void benchmark_reducoes(int partidas, double limite_ms, bool reduzir, bool estender);
+
+// Escreve as estatísticas da busca em uma linha de log (SDL_Log)
+void registrar_estatisticas(const EstatisticasBusca* e);
+
+#endif
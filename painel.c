@@ -0,0 +1,158 @@
+/*
+    Painel de desempenho (ver painel.h).
+*/
+
+#include "painel.h"
+
+#include <SDL2/SDL_test_font.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PAINEL_MARGEM 4                   // Espaço entre a borda do painel e o conteúdo
+#define PAINEL_X 8                        // Canto superior esquerdo do painel na tela
+#define PAINEL_Y 8
+#define PAINEL_LARGURA_TEXTO (PAINEL_COLUNAS * FONT_CHARACTER_SIZE)
+#define PAINEL_ALTURA_TEXTO (PAINEL_LINHAS * FONT_LINE_HEIGHT)
+#define PAINEL_ALTURA_GRAFICO 60
+#define PAINEL_ESCALA_MS 50.0f            // Tempo correspondente à altura toda do gráfico
+#define PAINEL_ALVO_MS (1000.0f / 60.0f)  // Linha de referência: um quadro a 60 Hz
+#define PAINEL_LENTO_MS (1.5f * PAINEL_ALVO_MS) // Acima disso a barra fica vermelha (quadro perdido)
+
+bool painel_criar(PainelDesempenho* painel, SDL_Renderer* renderer) {
+    memset(painel, 0, sizeof(*painel));
+    painel->texto = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                      PAINEL_LARGURA_TEXTO, PAINEL_ALTURA_TEXTO);
+    if (painel->texto) SDL_SetTextureBlendMode(painel->texto, SDL_BLENDMODE_BLEND);
+    painel->inicio_quadro = SDL_GetPerformanceCounter();
+    return painel->texto != NULL;
+}
+
+void painel_destruir(PainelDesempenho* painel) {
+    if (painel->texto) SDL_DestroyTexture(painel->texto);
+    painel->texto = NULL;
+    SDLTest_CleanupTextDrawing(); // Texturas dos caracteres guardadas pela SDL_test_font
+}
+
+void painel_alternar(PainelDesempenho* painel) {
+    painel->visivel = !painel->visivel;
+    painel->conteudo[0][0] = '\0'; // Ao reaparecer, o texto é refeito na hora
+    painel->ultima_atualizacao = 0;
+}
+
+void painel_invalidar(PainelDesempenho* painel) {
+    painel->conteudo[0][0] = '\0';
+}
+
+void painel_inicio_quadro(PainelDesempenho* painel) {
+    painel->inicio_quadro = SDL_GetPerformanceCounter();
+    painel->desenhos = 0;
+}
+
+void painel_contar_desenhos(PainelDesempenho* painel, int chamadas) {
+    painel->desenhos += chamadas;
+}
+
+bool painel_precisa_atualizar(const PainelDesempenho* painel) {
+    return painel->visivel && SDL_TICKS_PASSED(SDL_GetTicks(), painel->ultima_atualizacao + PAINEL_ATUALIZACAO_MS);
+}
+
+static void desenhar_linhas(SDL_Renderer* renderer, char linhas[PAINEL_LINHAS][PAINEL_COLUNAS + 1], int x, int y) {
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // A fonte usa a cor de desenho
+    for (int i = 0; i < PAINEL_LINHAS; i++) SDLTest_DrawString(renderer, x, y + i * FONT_LINE_HEIGHT, linhas[i]);
+}
+
+// Monta o texto do painel; fica só com o começo das linhas longas demais
+static void montar_texto(const PainelDesempenho* painel, int animacoes, const char* estado_ia,
+                         char linhas[PAINEL_LINHAS][PAINEL_COLUNAS + 1]) {
+    int n = painel->num_tempos < PAINEL_HISTORICO ? painel->num_tempos : PAINEL_HISTORICO;
+    float ultimo = 0, soma = 0, pior = 0;
+    for (int i = 0; i < n; i++) {
+        float t = painel->tempos_ms[i];
+        soma += t;
+        if (t > pior) pior = t;
+    }
+    if (n > 0) ultimo = painel->tempos_ms[(painel->proximo + PAINEL_HISTORICO - 1) % PAINEL_HISTORICO];
+    snprintf(linhas[0], PAINEL_COLUNAS + 1, "quadro %5.1f ms  medio %5.1f  pior %5.1f", ultimo,
+             n ? soma / (float)n : 0.0f, pior);
+    snprintf(linhas[1], PAINEL_COLUNAS + 1, "desenhos por quadro %d", painel->desenhos);
+    snprintf(linhas[2], PAINEL_COLUNAS + 1, "pecas caindo %d", animacoes);
+    snprintf(linhas[3], PAINEL_COLUNAS + 1, "IA: %s", estado_ia);
+    snprintf(linhas[4], PAINEL_COLUNAS + 1, "grafico 0-%.0f ms, linha em %.1f ms", PAINEL_ESCALA_MS, PAINEL_ALVO_MS);
+}
+
+void painel_desenhar(PainelDesempenho* painel, SDL_Renderer* renderer, int animacoes, const char* estado_ia) {
+    if (!painel->visivel) return;
+
+    // Refaz a textura do texto se ele mudou e já passou o intervalo mínimo (o tempo de quadro muda quase sempre)
+    char linhas[PAINEL_LINHAS][PAINEL_COLUNAS + 1];
+    bool vencido = painel->conteudo[0][0] == '\0' || painel_precisa_atualizar(painel);
+    if (vencido) {
+        montar_texto(painel, animacoes, estado_ia, linhas);
+        if (memcmp(linhas, painel->conteudo, sizeof(linhas)) != 0) {
+            memcpy(painel->conteudo, linhas, sizeof(linhas));
+            if (painel->texto) {
+                SDL_Texture* alvo_anterior = SDL_GetRenderTarget(renderer);
+                SDL_SetRenderTarget(renderer, painel->texto);
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+                SDL_RenderClear(renderer);
+                desenhar_linhas(renderer, painel->conteudo, 0, 0);
+                SDL_SetRenderTarget(renderer, alvo_anterior);
+            }
+        }
+        painel->ultima_atualizacao = SDL_GetTicks();
+    }
+
+    SDL_BlendMode mistura_anterior;
+    SDL_GetRenderDrawBlendMode(renderer, &mistura_anterior);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // Fundo escuro translúcido
+    SDL_Rect fundo = {PAINEL_X, PAINEL_Y, PAINEL_LARGURA_TEXTO + 2 * PAINEL_MARGEM,
+                      PAINEL_ALTURA_TEXTO + PAINEL_ALTURA_GRAFICO + 3 * PAINEL_MARGEM};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &fundo);
+
+    int x = PAINEL_X + PAINEL_MARGEM, y = PAINEL_Y + PAINEL_MARGEM;
+    if (painel->texto) {
+        SDL_Rect destino = {x, y, PAINEL_LARGURA_TEXTO, PAINEL_ALTURA_TEXTO};
+        SDL_RenderCopy(renderer, painel->texto, NULL, &destino);
+    } else {
+        desenhar_linhas(renderer, painel->conteudo, x, y);
+    }
+
+    // Gráfico: uma barra por quadro, do mais antigo (esquerda) ao mais recente; as lentas em vermelho
+    int base = y + PAINEL_ALTURA_TEXTO + PAINEL_MARGEM + PAINEL_ALTURA_GRAFICO;
+    int largura_barra = PAINEL_LARGURA_TEXTO / PAINEL_HISTORICO;
+    SDL_Rect normais[PAINEL_HISTORICO], lentas[PAINEL_HISTORICO];
+    int num_normais = 0, num_lentas = 0;
+    int n = painel->num_tempos < PAINEL_HISTORICO ? painel->num_tempos : PAINEL_HISTORICO;
+    for (int i = 0; i < n; i++) {
+        int indice = (painel->proximo + PAINEL_HISTORICO - n + i) % PAINEL_HISTORICO;
+        float t = painel->tempos_ms[indice];
+        int altura = (int)(t / PAINEL_ESCALA_MS * PAINEL_ALTURA_GRAFICO + 0.5f);
+        if (altura > PAINEL_ALTURA_GRAFICO) altura = PAINEL_ALTURA_GRAFICO;
+        if (altura < 1) altura = 1;
+        SDL_Rect barra = {x + (PAINEL_HISTORICO - n + i) * largura_barra, base - altura, largura_barra, altura};
+        if (t > PAINEL_LENTO_MS) lentas[num_lentas++] = barra;
+        else normais[num_normais++] = barra;
+    }
+    SDL_SetRenderDrawColor(renderer, 80, 220, 80, 255);
+    if (num_normais) SDL_RenderFillRects(renderer, normais, num_normais);
+    SDL_SetRenderDrawColor(renderer, 230, 60, 60, 255);
+    if (num_lentas) SDL_RenderFillRects(renderer, lentas, num_lentas);
+    int y_alvo = base - (int)(PAINEL_ALVO_MS / PAINEL_ESCALA_MS * PAINEL_ALTURA_GRAFICO + 0.5f);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 120);
+    SDL_RenderDrawLine(renderer, x, y_alvo, x + PAINEL_LARGURA_TEXTO - 1, y_alvo);
+
+    SDL_SetRenderDrawBlendMode(renderer, mistura_anterior);
+}
+
+void painel_quadro_apresentado(PainelDesempenho* painel, bool animando) {
+    Uint64 agora = SDL_GetPerformanceCounter();
+    Uint64 inicio = painel->em_sequencia && animando ? painel->ultimo_present : painel->inicio_quadro;
+    painel->tempos_ms[painel->proximo] = (float)((double)(agora - inicio) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    painel->proximo = (painel->proximo + 1) % PAINEL_HISTORICO;
+    painel->num_tempos++;
+    painel->ultimo_present = agora;
+    painel->em_sequencia = animando;
+}
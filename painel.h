@@ -0,0 +1,70 @@
+/*
+    Painel de desempenho sobreposto ao jogo (liga e desliga com F3).
+
+    Mostra o tempo do último quadro (com média e pior da janela recente), um
+    gráfico com os tempos dos últimos PAINEL_HISTORICO quadros, as chamadas
+    de desenho por quadro, as peças caindo e o estado da IA, para achar
+    engasgos sem um profiler externo. O texto é desenhado com a fonte de
+    SDL_test_font em uma textura, refeita só quando o texto muda e no máximo
+    a cada PAINEL_ATUALIZACAO_MS; por quadro, o painel custa cinco chamadas
+    de desenho (fundo, texto, barras em duas cores e linha de referência).
+
+    Tempo de um quadro: durante uma animação, o intervalo entre dois
+    SDL_RenderPresent seguidos; num quadro isolado (clique, IA), o tempo
+    entre o laço acordar e o Present terminar.
+*/
+
+#ifndef PAINEL_H
+#define PAINEL_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define PAINEL_HISTORICO 120        // Quadros no gráfico
+#define PAINEL_ATUALIZACAO_MS 250   // Intervalo mínimo entre duas atualizações do texto
+#define PAINEL_LINHAS 5             // Linhas de texto
+#define PAINEL_COLUNAS 44           // Caracteres por linha
+
+typedef struct {
+    bool visivel;
+    SDL_Texture* texto;                       // Texto já desenhado (NULL sem texturas alvo: desenha direto)
+    char conteudo[PAINEL_LINHAS][PAINEL_COLUNAS + 1]; // Texto que está na textura
+    Uint32 ultima_atualizacao;
+    Uint64 inicio_quadro;                     // Contador quando o laço acordou para desenhar este quadro
+    Uint64 ultimo_present;
+    bool em_sequencia;                        // O quadro anterior fazia parte de uma animação
+    float tempos_ms[PAINEL_HISTORICO];        // Circular; tempos_ms[proximo] é o mais antigo
+    int proximo;
+    int num_tempos;
+    int desenhos;                             // Chamadas de desenho do quadro em andamento
+} PainelDesempenho;
+
+bool painel_criar(PainelDesempenho* painel, SDL_Renderer* renderer);
+void painel_destruir(PainelDesempenho* painel);
+
+void painel_alternar(PainelDesempenho* painel);
+
+// A textura do texto perdeu o conteúdo (SDL_RENDER_TARGETS_RESET/DEVICE_RESET): refaz no próximo quadro
+void painel_invalidar(PainelDesempenho* painel);
+
+// No início de cada quadro desenhado (depois das esperas)
+void painel_inicio_quadro(PainelDesempenho* painel);
+
+// Soma chamadas de desenho ao quadro em andamento
+void painel_contar_desenhos(PainelDesempenho* painel, int chamadas);
+
+/*
+    Desenha o painel por cima do quadro (se visível). `animacoes` são as peças
+    caindo e `estado_ia`, uma linha com o que a IA está fazendo. Chamada
+    logo antes de SDL_RenderPresent; as chamadas do próprio painel não entram
+    na contagem.
+*/
+void painel_desenhar(PainelDesempenho* painel, SDL_Renderer* renderer, int animacoes, const char* estado_ia);
+
+// Logo depois de SDL_RenderPresent; `animando` como em ritmo_quadro_apresentado
+void painel_quadro_apresentado(PainelDesempenho* painel, bool animando);
+
+// O texto está vencido (para redesenhar de tempos em tempos enquanto a IA pensa)
+bool painel_precisa_atualizar(const PainelDesempenho* painel);
+
+#endif
@@ -0,0 +1,16 @@
+/*
+    Pesos da avaliação estática (pontos por janela aberta, do ponto de vista
+    do jogador da vez), em 1/ESCALA_PESOS de ponto (ver motor.h).
+
+    Arquivo gerado pelo tunador (tunador.c) a partir de partidas de autojogo;
+    rode o tunador de novo em vez de editar à mão.
+    Última geração: 4000 partidas, 69192 posições, erro médio 0.19893.
+*/
+
+#ifndef PESOS_AVALIACAO_H
+#define PESOS_AVALIACAO_H
+
+#define PESO_JANELA_DOIS 15 // Janela com 2 peças de um jogador e 2 casas vazias
+#define PESO_JANELA_TRES 43 // Janela com 3 peças de um jogador e 1 casa vazia
+
+#endif
@@ -0,0 +1,205 @@
+/*
+    Partidas aleatórias (playouts) escalares e vetoriais.
+*/
+
+#include "playout.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+// Espalha a semente para que vias e lotes vizinhos comecem em estados distantes (splitmix64)
+static uint64_t misturar_semente(uint64_t x) {
+    x += UINT64_C(0x9E3779B97F4A7C15);
+    x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+    x ^= x >> 31;
+    return x ? x : 1; // xorshift não pode partir do zero
+}
+
+/*
+    Versão escalar de referência: sorteia colunas até achar uma livre e joga
+    até alguém fazer 4 em linha ou o tabuleiro encher.
+*/
+void playouts_escalares(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r) {
+    uint64_t rng = misturar_semente(semente);
+    r->vitorias = r->derrotas = r->empates = 0;
+
+    for (int n = 0; n < num_playouts; n++) {
+        Posicao p = *raiz;
+        for (;;) {
+            if (p.jogadas == TOTAL_CASAS) {
+                r->empates++;
+                break;
+            }
+            int coluna = (int)(((xorshift64(&rng) >> 32) * COLUNAS) >> 32);
+            if (!pode_jogar(&p, coluna)) continue;
+            if (jogada_vencedora(&p, coluna)) {
+                // Quem venceu é o jogador da vez na raiz se já se passou um número par de jogadas
+                if ((p.jogadas - raiz->jogadas) % 2 == 0) r->vitorias++;
+                else r->derrotas++;
+                break;
+            }
+            jogar_coluna(&p, coluna);
+        }
+    }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+// Vetor de 4 bitboards (um registrador AVX2); PLAYOUT_VIAS / 4 vetores formam um lote
+#define VIAS_POR_VETOR 4
+#define VETORES_POR_LOTE (PLAYOUT_VIAS / VIAS_POR_VETOR)
+#if PLAYOUT_VIAS % VIAS_POR_VETOR != 0
+#error "PLAYOUT_VIAS deve ser múltiplo de VIAS_POR_VETOR"
+#endif
+typedef uint64_t VetorU64 __attribute__((vector_size(VIAS_POR_VETOR * sizeof(uint64_t))));
+typedef int64_t VetorI64 __attribute__((vector_size(VIAS_POR_VETOR * sizeof(int64_t))));
+
+// Bits aleatórios usados para sortear uma coluna (o suficiente para cobrir COLUNAS)
+#define BITS_SORTEIO_COLUNA (COLUNAS <= 4 ? 2 : COLUNAS <= 8 ? 3 : 4)
+
+// Estado de VIAS_POR_VETOR partidas em andamento
+typedef struct {
+    VetorU64 atual, mascara, jogadas, ativo, rng;
+    VetorU64 venceu_raiz, perdeu_raiz;
+} VetorPartidas;
+
+/*
+    Avança uma jogada em cada via ativa: sorteia uma coluna, joga se ela
+    estiver livre e desativa as vias cuja partida terminou. Tudo é feito com
+    máscaras, sem desvios por via.
+*/
+static inline __attribute__((always_inline))
+void passo_playout(VetorPartidas* g, uint64_t jogadas_raiz) {
+    const VetorU64 zero = {0};
+    const VetorU64 um = zero + 1;
+
+    // xorshift64 em todas as vias
+    g->rng ^= g->rng << 13;
+    g->rng ^= g->rng >> 7;
+    g->rng ^= g->rng << 17;
+
+    // Coluna sorteada pelos bits altos (sorteios fora do tabuleiro são rejeitados,
+    // pois AVX2 não tem multiplicação de 64 bits) e a casa onde a peça cairia (0 se cheia)
+    VetorU64 coluna = g->rng >> (64 - BITS_SORTEIO_COLUNA);
+    VetorU64 deslocamento = coluna * ALTURA;
+    VetorU64 novo = (g->mascara + (um << deslocamento)) & ((zero + ((UINT64_C(1) << LINHAS) - 1)) << deslocamento);
+    VetorU64 joga = g->ativo & (VetorU64)((VetorI64)coluna < COLUNAS) & ~(VetorU64)((VetorI64)novo == 0);
+    novo &= joga;
+
+    // Mesmo teste de tem_alinhamento(), nas quatro direções e em todas as vias
+    VetorU64 pecas = g->atual | novo;
+    VetorU64 m = pecas & (pecas >> 1);
+    VetorU64 linha = m & (m >> 2);
+    m = pecas & (pecas >> ALTURA);
+    linha |= m & (m >> (2 * ALTURA));
+    m = pecas & (pecas >> (ALTURA - 1));
+    linha |= m & (m >> (2 * (ALTURA - 1)));
+    m = pecas & (pecas >> (ALTURA + 1));
+    linha |= m & (m >> (2 * (ALTURA + 1)));
+
+    VetorU64 venceu = joga & ~(VetorU64)((VetorI64)linha == 0);
+    VetorU64 vez_raiz = (VetorU64)((VetorI64)((g->jogadas - jogadas_raiz) & 1) == 0);
+    g->venceu_raiz |= venceu & vez_raiz;
+    g->perdeu_raiz |= venceu & ~vez_raiz;
+
+    // Nas vias que jogaram, a vez passa ao adversário
+    g->atual ^= g->mascara & joga;
+    g->mascara |= novo;
+    g->jogadas += joga & 1;
+
+    VetorU64 cheio = joga & ~venceu & (VetorU64)((VetorI64)g->jogadas == TOTAL_CASAS);
+    g->ativo &= ~(venceu | cheio);
+}
+
+/*
+    Núcleo vetorial: joga as partidas em lotes de PLAYOUT_VIAS, todas
+    avançando juntas até a última do lote terminar.
+*/
+static inline __attribute__((always_inline))
+void nucleo_playouts(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r) {
+    const VetorU64 zero = {0};
+    r->vitorias = r->derrotas = r->empates = 0;
+
+    for (int lote = 0; lote < num_playouts; lote += PLAYOUT_VIAS) {
+        VetorPartidas g[VETORES_POR_LOTE];
+        for (int k = 0; k < VETORES_POR_LOTE; k++) {
+            g[k].atual = zero + raiz->atual;
+            g[k].mascara = zero + raiz->mascara;
+            g[k].jogadas = zero + (uint64_t)raiz->jogadas;
+            g[k].venceu_raiz = g[k].perdeu_raiz = zero;
+            for (int v = 0; v < VIAS_POR_VETOR; v++) {
+                int n = lote + k * VIAS_POR_VETOR + v;
+                g[k].rng[v] = misturar_semente(semente + (uint64_t)n);
+                g[k].ativo[v] = (n < num_playouts && raiz->jogadas < TOTAL_CASAS) ? ~UINT64_C(0) : 0;
+            }
+        }
+
+        for (;;) {
+            VetorU64 ativos = zero;
+            for (int k = 0; k < VETORES_POR_LOTE; k++) {
+                passo_playout(&g[k], (uint64_t)raiz->jogadas);
+                ativos |= g[k].ativo;
+            }
+            uint64_t algum_ativo = 0;
+            for (int v = 0; v < VIAS_POR_VETOR; v++) algum_ativo |= ativos[v];
+            if (!algum_ativo) break;
+        }
+
+        for (int k = 0; k < VETORES_POR_LOTE; k++) {
+            for (int v = 0; v < VIAS_POR_VETOR; v++) {
+                if (lote + k * VIAS_POR_VETOR + v >= num_playouts) break;
+                if (g[k].venceu_raiz[v]) r->vitorias++;
+                else if (g[k].perdeu_raiz[v]) r->derrotas++;
+                else r->empates++;
+            }
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Mesmo núcleo compilado para AVX2, escolhido em tempo de execução
+__attribute__((target("avx2")))
+static void playouts_avx2(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r) {
+    nucleo_playouts(raiz, num_playouts, semente, r);
+}
+#endif
+
+void playouts_vetoriais(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (SDL_HasAVX2()) {
+        playouts_avx2(raiz, num_playouts, semente, r);
+        return;
+    }
+#endif
+    nucleo_playouts(raiz, num_playouts, semente, r);
+}
+
+#else
+
+// Compiladores sem extensões vetoriais usam a versão escalar
+void playouts_vetoriais(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r) {
+    playouts_escalares(raiz, num_playouts, semente, r);
+}
+
+#endif
+
+static double medir_playouts(void (*kernel)(const Posicao*, int, uint64_t, ResultadoPlayouts*),
+                             const char* nome, int num_playouts) {
+    Posicao vazio = {0, 0, 0};
+    ResultadoPlayouts r;
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    kernel(&vazio, num_playouts, 12345, &r);
+    double segundos = (double)(SDL_GetPerformanceCounter() - inicio) / (double)SDL_GetPerformanceFrequency();
+    double por_segundo = segundos > 0 ? num_playouts / segundos : 0.0;
+    printf("%-9s %d playouts em %.3f s (%.0f playouts/s) - J1 %.1f%% J2 %.1f%% empate %.1f%%\n",
+           nome, num_playouts, segundos, por_segundo,
+           100.0 * r.vitorias / num_playouts, 100.0 * r.derrotas / num_playouts, 100.0 * r.empates / num_playouts);
+    return por_segundo;
+}
+
+void benchmark_playouts(int num_playouts) {
+    double escalar = medir_playouts(playouts_escalares, "escalar", num_playouts);
+    double vetorial = medir_playouts(playouts_vetoriais, "vetorial", num_playouts);
+    if (escalar > 0) printf("Ganho do nucleo vetorial (%d vias): %.2fx\n", PLAYOUT_VIAS, vetorial / escalar);
+}
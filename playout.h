@@ -0,0 +1,41 @@
+/*
+    Partidas aleatórias (playouts) para avaliação por Monte Carlo.
+
+    O núcleo vetorial joga PLAYOUT_VIAS partidas independentes ao mesmo tempo:
+    cada via de um registrador SIMD guarda o bitboard e o gerador aleatório
+    (xorshift) de uma partida, e todas avançam juntas uma jogada por passo.
+*/
+
+#ifndef PLAYOUT_H
+#define PLAYOUT_H
+
+#include "motor.h"
+
+#define PLAYOUT_VIAS 8 // Partidas simultâneas no núcleo vetorial
+
+// Resultado de um lote de partidas, do ponto de vista do jogador da vez na raiz
+typedef struct {
+    uint64_t vitorias;
+    uint64_t derrotas;
+    uint64_t empates;
+} ResultadoPlayouts;
+
+// Gerador xorshift64: rápido e com estado próprio (não usa o rand() global)
+static inline uint64_t xorshift64(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *estado = x;
+}
+
+// Joga num_playouts partidas aleatórias a partir de raiz, uma por vez
+void playouts_escalares(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r);
+
+// Igual a playouts_escalares, mas PLAYOUT_VIAS partidas por vez em vetores SIMD
+void playouts_vetoriais(const Posicao* raiz, int num_playouts, uint64_t semente, ResultadoPlayouts* r);
+
+// Compara playouts por segundo do núcleo vetorial com o escalar
+void benchmark_playouts(int num_playouts);
+
+#endif
@@ -0,0 +1,270 @@
+/*
+    Busca por números de prova (ver prova.h).
+*/
+
+#include "prova.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(NoProva) == 32, "NoProva deve ocupar 32 bytes");
+
+// Expansões entre duas leituras do relógio
+#define EXPANSOES_ENTRE_CHECAGENS 256
+
+bool prova_criar(TabelaProva* tabela, size_t megabytes) {
+    memset(tabela, 0, sizeof(*tabela));
+    uint64_t n = (uint64_t)megabytes * 1024 * 1024 / sizeof(NoProva);
+    if (n > UINT32_MAX) n = UINT32_MAX;
+    if (n < 2) return false;
+    tabela->nos = malloc((size_t)n * sizeof(NoProva));
+    tabela->capacidade = tabela->nos ? (uint32_t)n : 0;
+    return tabela->nos != NULL;
+}
+
+void prova_destruir(TabelaProva* tabela) {
+    free(tabela->nos);
+    memset(tabela, 0, sizeof(*tabela));
+}
+
+static inline uint32_t somar_saturado(uint32_t a, uint32_t b) {
+    return a > PROVA_INFINITO - b ? PROVA_INFINITO : a + b;
+}
+
+static inline void marcar(NoProva* no, bool vitoria) {
+    no->prova = vitoria ? 0 : PROVA_INFINITO;
+    no->refutacao = vitoria ? PROVA_INFINITO : 0;
+}
+
+/*
+    Valores iniciais de um nó recém-criado. `ou` indica se é a vez do jogador
+    da raiz (nó OU: basta um filho vencedor) ou do adversário (nó E: todos
+    os filhos precisam vencer). Jogadas forçadas e paridade resolvem muitos
+    nós já aqui, sem expandir.
+*/
+static void avaliar_no(NoProva* no, bool ou) {
+    Posicao p = {no->atual, no->mascara, no->jogadas};
+    no->primeiro_filho = 0;
+    no->num_filhos = 0;
+
+    if (p.jogadas == TOTAL_CASAS) { // Empate: não é vitória do jogador da raiz
+        marcar(no, false);
+        return;
+    }
+    JogadasForcadas forcadas = analisar_jogadas_forcadas(&p);
+    if (forcadas.vitorias) { // O jogador da vez vence na próxima jogada
+        marcar(no, ou);
+        return;
+    }
+    if (forcadas.seguras == 0) { // O jogador da vez perde na jogada seguinte
+        marcar(no, !ou);
+        return;
+    }
+    int paridade = analisar_paridade(&p).resultado;
+    if (paridade == PARIDADE_DERROTA) {
+        marcar(no, !ou);
+        return;
+    }
+    if (paridade == PARIDADE_SEM_VITORIA && ou) {
+        marcar(no, false);
+        return;
+    }
+    // Folha em aberto: quanto mais jogadas seguras, mais difícil refutar (nó OU) ou provar (nó E)
+    int seguras = CONTAR_BITS(forcadas.seguras);
+    no->prova = ou ? 1 : (uint32_t)seguras;
+    no->refutacao = ou ? (uint32_t)seguras : 1;
+}
+
+// Cria um filho por jogada segura; retorna false se a tabela estiver cheia
+static bool expandir(TabelaProva* tabela, uint32_t i, bool ou) {
+    NoProva* no = &tabela->nos[i];
+    Posicao p = {no->atual, no->mascara, no->jogadas};
+    uint64_t seguras = jogadas_sem_derrota(&p);
+    uint32_t n = (uint32_t)CONTAR_BITS(seguras);
+    if (n > tabela->capacidade - tabela->usados) return false;
+
+    uint32_t primeiro = tabela->usados;
+    tabela->usados += n;
+    NoProva* filho = &tabela->nos[primeiro];
+    for (int c = 0; c < COLUNAS; c++) {
+        if (!(seguras & mascara_coluna(c))) continue;
+        Posicao q = p;
+        jogar_coluna(&q, c);
+        filho->atual = q.atual;
+        filho->mascara = q.mascara;
+        filho->jogadas = (uint8_t)q.jogadas;
+        filho->coluna = (int8_t)c;
+        filho->reservado = 0;
+        avaliar_no(filho, !ou);
+        filho++;
+    }
+    no->primeiro_filho = primeiro;
+    no->num_filhos = (uint8_t)n;
+    return true;
+}
+
+// Recalcula os números de um nó expandido a partir dos filhos
+static void atualizar(TabelaProva* tabela, uint32_t i, bool ou) {
+    NoProva* no = &tabela->nos[i];
+    uint32_t minimo = PROVA_INFINITO, soma = 0;
+    for (uint32_t f = no->primeiro_filho; f < no->primeiro_filho + no->num_filhos; f++) {
+        const NoProva* filho = &tabela->nos[f];
+        uint32_t escolhido = ou ? filho->prova : filho->refutacao;
+        uint32_t somado = ou ? filho->refutacao : filho->prova;
+        if (escolhido < minimo) minimo = escolhido;
+        soma = somar_saturado(soma, somado);
+    }
+    no->prova = ou ? minimo : soma;
+    no->refutacao = ou ? soma : minimo;
+}
+
+// Filho que mais ajuda a resolver o nó: menor prova num nó OU, menor refutação num nó E
+static uint32_t mais_promissor(const TabelaProva* tabela, uint32_t i, bool ou) {
+    const NoProva* no = &tabela->nos[i];
+    uint32_t melhor = no->primeiro_filho;
+    uint32_t melhor_valor = PROVA_INFINITO;
+    for (uint32_t f = no->primeiro_filho; f < no->primeiro_filho + no->num_filhos; f++) {
+        uint32_t v = ou ? tabela->nos[f].prova : tabela->nos[f].refutacao;
+        if (v < melhor_valor) {
+            melhor_valor = v;
+            melhor = f;
+        }
+    }
+    return melhor;
+}
+
+ResultadoProva provar_vitoria(TabelaProva* tabela, const Posicao* p, double limite_ms, TabelaTransposicao* tt) {
+    ResultadoProva r;
+    memset(&r, 0, sizeof(r));
+    r.coluna = -1;
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    Uint64 prazo = limite_ms > 0 ? inicio + (Uint64)(limite_ms * frequencia / 1000.0) : 0;
+
+    NoProva* raiz = &tabela->nos[0];
+    raiz->atual = p->atual;
+    raiz->mascara = p->mascara;
+    raiz->jogadas = (uint8_t)p->jogadas;
+    raiz->coluna = -1;
+    avaliar_no(raiz, true);
+    tabela->usados = 1;
+
+    bool cheia = false;
+    uint32_t caminho[TOTAL_CASAS + 1];
+    while (raiz->prova != 0 && raiz->refutacao != 0) {
+        if (prazo && r.expansoes % EXPANSOES_ENTRE_CHECAGENS == 0 && SDL_GetPerformanceCounter() >= prazo) break;
+
+        // Desce até a folha mais promissora (a profundidade decide se o nó é OU ou E)
+        int n = 0;
+        uint32_t i = 0;
+        caminho[n++] = 0;
+        while (tabela->nos[i].num_filhos) {
+            i = mais_promissor(tabela, i, n % 2 == 1);
+            caminho[n++] = i;
+        }
+        if (!expandir(tabela, i, n % 2 == 1)) {
+            cheia = true;
+            break;
+        }
+        r.expansoes++;
+
+        // Só os ancestrais da folha mudam; para quando um deles não muda mais
+        for (int j = n - 1; j >= 0; j--) {
+            NoProva* no = &tabela->nos[caminho[j]];
+            uint32_t prova = no->prova, refutacao = no->refutacao;
+            atualizar(tabela, caminho[j], j % 2 == 0);
+            if (j < n - 1 && no->prova == prova && no->refutacao == refutacao) break;
+        }
+    }
+
+    if (raiz->prova == 0) {
+        r.resultado = PROVA_VITORIA;
+        JogadasForcadas forcadas = analisar_jogadas_forcadas(p);
+        if (forcadas.vitorias) r.coluna = coluna_da_jogada(forcadas.vitorias & -forcadas.vitorias);
+        for (uint32_t f = raiz->primeiro_filho; r.coluna < 0 && f < raiz->primeiro_filho + raiz->num_filhos; f++)
+            if (tabela->nos[f].prova == 0) r.coluna = tabela->nos[f].coluna;
+    } else if (raiz->refutacao == 0) {
+        r.resultado = PROVA_SEM_VITORIA;
+    } else if (cheia) {
+        // Tabela cheia: o alfa-beta resolve até o fim da partida no tempo que sobra
+        r.usou_alfabeta = true;
+        double restante_ms = 0;
+        if (prazo) {
+            restante_ms = ((double)prazo - (double)SDL_GetPerformanceCounter()) * 1000.0 / frequencia;
+            if (restante_ms < 1) restante_ms = 1;
+        }
+        ResultadoBusca busca = buscar_jogada_com_prazo(p, TOTAL_CASAS - p->jogadas, restante_ms, tt, NULL);
+        if (busca.pontuacao >= PONTUACAO_MINIMA_VITORIA) {
+            r.resultado = PROVA_VITORIA;
+            r.coluna = busca.coluna;
+        } else if (busca.resolvida) {
+            r.resultado = PROVA_SEM_VITORIA;
+        }
+    }
+
+    r.nos = tabela->usados;
+    r.segundos = (double)(SDL_GetPerformanceCounter() - inicio) / frequencia;
+    return r;
+}
+
+/*
+    Posições táticas (colunas de 1 a 7 a partir do tabuleiro vazio), tiradas
+    de partidas aleatórias entre a 10ª e a 20ª jogada: o alfa-beta resolve
+    cada uma até o fim da partida em 20 ms a 1 s.
+*/
+static const char* const posicoes_taticas[] = {
+    "211574772472", "63412616356464", "3742247545155", "257162376671145", "47472513112332",
+    "4371277527", "3125635123225", "7454222443325125", "123637433342444", "73535445462335",
+    "1236446166346", "461414727445547726", "261764531574332255", "5575144342316", "62675775255771",
+    "75612446762", "66477531432571611553", "54322623345", "5645573242134423", "67457234766237",
+    "14723126735365", "7775153213755577",
+};
+
+static const char* nome_resultado(int resultado) {
+    return resultado == PROVA_VITORIA ? "vitoria" : resultado == PROVA_SEM_VITORIA ? "sem vitoria" : "?";
+}
+
+void benchmark_prova(TabelaProva* tabela, TabelaTransposicao* tt, double limite_ms) {
+    int num = (int)(sizeof(posicoes_taticas) / sizeof(posicoes_taticas[0]));
+    double total[2] = {0, 0};
+    int resolvidas[2] = {0, 0}, divergencias = 0, mais_rapida = 0, cheias = 0;
+
+    printf("%-24s %-12s %10s %10s | %-12s %10s %10s\n", "posicao", "prova", "expansoes", "ms",
+           "alfa-beta", "nos", "ms");
+    for (int i = 0; i < num; i++) {
+        Posicao p = {0, 0, 0};
+        bool valida = true;
+        for (const char* s = posicoes_taticas[i]; *s && valida; s++) {
+            int c = *s - '1';
+            valida = c >= 0 && c < COLUNAS && pode_jogar(&p, c) && !jogada_vencedora(&p, c);
+            if (valida) jogar_coluna(&p, c);
+        }
+        if (!valida) continue;
+
+        ResultadoProva rp = provar_vitoria(tabela, &p, limite_ms, tt);
+
+        if (tt) tt_limpar(tt);
+        ResultadoBusca rb = buscar_jogada_com_prazo(&p, TOTAL_CASAS - p.jogadas, limite_ms, tt, NULL);
+        int resultado_ab = rb.pontuacao >= PONTUACAO_MINIMA_VITORIA ? PROVA_VITORIA
+                         : rb.resolvida ? PROVA_SEM_VITORIA : PROVA_DESCONHECIDA;
+
+        printf("%-24s %-12s %10llu %10.2f | %-12s %10llu %10.2f%s\n", posicoes_taticas[i],
+               nome_resultado(rp.resultado), (unsigned long long)rp.expansoes, rp.segundos * 1000.0,
+               nome_resultado(resultado_ab), (unsigned long long)rb.estatisticas.nos,
+               rb.estatisticas.segundos * 1000.0, rp.usou_alfabeta ? " (tabela cheia)" : "");
+        total[0] += rp.segundos;
+        total[1] += rb.estatisticas.segundos;
+        mais_rapida += rp.resultado != PROVA_DESCONHECIDA && rp.segundos < rb.estatisticas.segundos;
+        cheias += rp.usou_alfabeta;
+        resolvidas[0] += rp.resultado != PROVA_DESCONHECIDA;
+        resolvidas[1] += resultado_ab != PROVA_DESCONHECIDA;
+        if (rp.resultado != PROVA_DESCONHECIDA && resultado_ab != PROVA_DESCONHECIDA && rp.resultado != resultado_ab)
+            divergencias++;
+    }
+    printf("Total: prova %d resolvidas em %.2f s, alfa-beta %d resolvidas em %.2f s, %d divergencias\n",
+           resolvidas[0], total[0], resolvidas[1], total[1], divergencias);
+    printf("Prova mais rapida em %d de %d posicoes; tabela de %u nos cheia em %d (resolvidas pelo alfa-beta)\n",
+           mais_rapida, num, tabela->capacidade, cheias);
+}
@@ -0,0 +1,66 @@
+/*
+    Busca por números de prova (proof-number search) para posições táticas.
+
+    Responde uma pergunta só: o jogador da vez tem vitória forçada? Cada nó
+    guarda o número de prova (quantas folhas ainda precisam ser provadas
+    para mostrar a vitória) e o de refutação (idem para mostrar que ela não
+    existe), e a busca sempre expande a folha "mais promissora". Em posições
+    cheias de ameaças, onde quase todas as jogadas são forçadas, ela chega à
+    prova com bem menos nós que o alfa-beta.
+
+    Os nós ficam numa tabela de tamanho fixo, com os filhos em blocos
+    contíguos apontados por índices de 32 bits (como em mcts.h). Se a tabela
+    encher antes da prova, a pergunta é repassada ao alfa-beta.
+*/
+
+#ifndef PROVA_H
+#define PROVA_H
+
+#include "motor.h"
+
+#define PROVA_INFINITO UINT32_MAX
+
+enum {
+    PROVA_DESCONHECIDA,  // Prazo esgotado antes de uma resposta
+    PROVA_VITORIA,       // O jogador da vez vence com jogo perfeito
+    PROVA_SEM_VITORIA    // O adversário consegue ao menos empatar
+};
+
+typedef struct {
+    uint64_t atual, mascara;  // Posição do nó (mesmo formato de Posicao)
+    uint32_t prova, refutacao;
+    uint32_t primeiro_filho;  // Índice do 1º filho (0 = não expandido; o 0 é sempre a raiz)
+    uint8_t num_filhos;
+    int8_t coluna;            // Jogada que levou ao nó
+    uint8_t jogadas;
+    uint8_t reservado;
+} NoProva;
+
+typedef struct {
+    NoProva* nos;
+    uint32_t capacidade;
+    uint32_t usados;
+} TabelaProva;
+
+typedef struct {
+    int resultado;            // PROVA_*
+    int coluna;               // Jogada vencedora (-1 se não há vitória provada)
+    uint64_t expansoes;       // Nós expandidos pela busca por números de prova
+    uint32_t nos;             // Nós ocupados na tabela
+    bool usou_alfabeta;       // A tabela encheu e a resposta veio do alfa-beta
+    double segundos;
+} ResultadoProva;
+
+bool prova_criar(TabelaProva* tabela, size_t megabytes);
+void prova_destruir(TabelaProva* tabela);
+
+/*
+    Tenta provar ou refutar a vitória do jogador da vez em até limite_ms
+    milissegundos (0 = sem prazo). tt é usada só no alfa-beta de reserva.
+*/
+ResultadoProva provar_vitoria(TabelaProva* tabela, const Posicao* p, double limite_ms, TabelaTransposicao* tt);
+
+// Compara o tempo até a prova com o alfa-beta resolvendo até o fim, no conjunto de posições táticas
+void benchmark_prova(TabelaProva* tabela, TabelaTransposicao* tt, double limite_ms);
+
+#endif
@@ -0,0 +1,310 @@
+/*
+    Avaliador por rede neural quantizada: carregamento dos pesos,
+    acumuladores incrementais e núcleos SIMD.
+*/
+
+#include "rede_neural.h"
+#include "playout.h" // xorshift64
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define REDE_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define ALVO_AVX2 __attribute__((target("avx2")))
+#define ALVO_SSE2 __attribute__((target("sse2")))
+#else
+#define ALVO_AVX2
+#define ALVO_SSE2
+#endif
+#endif
+
+#define REDE_VERSAO 1
+
+// Núcleos escolhidos em tempo de execução
+static void (*somar_linha)(int16_t* destino, const int16_t* linha);
+static void (*subtrair_linha)(int16_t* destino, const int16_t* linha);
+static int32_t (*produto_saida)(const int16_t* ativacao, const int16_t* pesos);
+static const char* nome_nucleo = "escalar";
+
+/*
+    Núcleos escalares (referência e fallback)
+*/
+static void somar_linha_escalar(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i++) destino[i] += linha[i];
+}
+
+static void subtrair_linha_escalar(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i++) destino[i] -= linha[i];
+}
+
+static int32_t produto_saida_escalar(const int16_t* ativacao, const int16_t* pesos) {
+    int32_t soma = 0;
+    for (int i = 0; i < REDE_OCULTOS; i++) {
+        int a = ativacao[i] < 0 ? 0 : (ativacao[i] > REDE_LIMITE_RELU ? REDE_LIMITE_RELU : ativacao[i]);
+        soma += a * pesos[i];
+    }
+    return soma;
+}
+
+#ifdef REDE_X86
+
+/*
+    Núcleos SSE2: 8 neurônios por instrução
+*/
+ALVO_SSE2 static void somar_linha_sse2(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(destino + i));
+        __m128i l = _mm_loadu_si128((const __m128i*)(linha + i));
+        _mm_storeu_si128((__m128i*)(destino + i), _mm_add_epi16(d, l));
+    }
+}
+
+ALVO_SSE2 static void subtrair_linha_sse2(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(destino + i));
+        __m128i l = _mm_loadu_si128((const __m128i*)(linha + i));
+        _mm_storeu_si128((__m128i*)(destino + i), _mm_sub_epi16(d, l));
+    }
+}
+
+ALVO_SSE2 static int32_t produto_saida_sse2(const int16_t* ativacao, const int16_t* pesos) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i teto = _mm_set1_epi16(REDE_LIMITE_RELU);
+    __m128i soma = _mm_setzero_si128();
+    for (int i = 0; i < REDE_OCULTOS; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(ativacao + i));
+        a = _mm_min_epi16(_mm_max_epi16(a, zero), teto);
+        soma = _mm_add_epi32(soma, _mm_madd_epi16(a, _mm_loadu_si128((const __m128i*)(pesos + i))));
+    }
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, _MM_SHUFFLE(1, 0, 3, 2)));
+    soma = _mm_add_epi32(soma, _mm_shuffle_epi32(soma, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(soma);
+}
+
+/*
+    Núcleos AVX2: 16 neurônios por instrução
+*/
+ALVO_AVX2 static void somar_linha_avx2(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(destino + i));
+        __m256i l = _mm256_loadu_si256((const __m256i*)(linha + i));
+        _mm256_storeu_si256((__m256i*)(destino + i), _mm256_add_epi16(d, l));
+    }
+}
+
+ALVO_AVX2 static void subtrair_linha_avx2(int16_t* destino, const int16_t* linha) {
+    for (int i = 0; i < REDE_OCULTOS; i += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(destino + i));
+        __m256i l = _mm256_loadu_si256((const __m256i*)(linha + i));
+        _mm256_storeu_si256((__m256i*)(destino + i), _mm256_sub_epi16(d, l));
+    }
+}
+
+ALVO_AVX2 static int32_t produto_saida_avx2(const int16_t* ativacao, const int16_t* pesos) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i teto = _mm256_set1_epi16(REDE_LIMITE_RELU);
+    __m256i soma = _mm256_setzero_si256();
+    for (int i = 0; i < REDE_OCULTOS; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(ativacao + i));
+        a = _mm256_min_epi16(_mm256_max_epi16(a, zero), teto);
+        soma = _mm256_add_epi32(soma, _mm256_madd_epi16(a, _mm256_loadu_si256((const __m256i*)(pesos + i))));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(soma), _mm256_extracti128_si256(soma, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+#endif
+
+// Escolhe os núcleos conforme a CPU (uma vez)
+static void escolher_nucleos(void) {
+    somar_linha = somar_linha_escalar;
+    subtrair_linha = subtrair_linha_escalar;
+    produto_saida = produto_saida_escalar;
+    nome_nucleo = "escalar";
+#ifdef REDE_X86
+    if (REDE_OCULTOS % 16 == 0 && SDL_HasAVX2()) {
+        somar_linha = somar_linha_avx2;
+        subtrair_linha = subtrair_linha_avx2;
+        produto_saida = produto_saida_avx2;
+        nome_nucleo = "avx2";
+    } else if (REDE_OCULTOS % 8 == 0 && SDL_HasSSE2()) {
+        somar_linha = somar_linha_sse2;
+        subtrair_linha = subtrair_linha_sse2;
+        produto_saida = produto_saida_sse2;
+        nome_nucleo = "sse2";
+    }
+#endif
+}
+
+const char* rede_nucleo(void) {
+    return nome_nucleo;
+}
+
+// Lê `n` inteiros de 16 bits little-endian; retorna false se o arquivo acabar antes
+static bool ler_le16(SDL_RWops* arquivo, int16_t* destino, size_t n) {
+    if (SDL_RWread(arquivo, destino, sizeof(int16_t), n) != n) return false;
+    for (size_t i = 0; i < n; i++) destino[i] = (int16_t)SDL_SwapLE16((Uint16)destino[i]);
+    return true;
+}
+
+bool rede_carregar(RedeNeural* rede, const char* caminho) {
+    SDL_RWops* arquivo = SDL_RWFromFile(caminho, "rb");
+    if (!arquivo) return false;
+
+    // Cada bloco é conferido; a rede só é trocada se o arquivo inteiro for lido
+    RedeNeural lida;
+    char magica[4];
+    Uint32 cabecalho[3], vies_saida;
+    int8_t saida[2 * REDE_OCULTOS];
+    bool ok = SDL_RWread(arquivo, magica, 1, 4) == 4 && memcmp(magica, "C4RN", 4) == 0 &&
+              SDL_RWread(arquivo, cabecalho, sizeof(Uint32), 3) == 3 &&
+              SDL_SwapLE32(cabecalho[0]) == REDE_VERSAO &&
+              SDL_SwapLE32(cabecalho[1]) == REDE_ENTRADAS &&
+              SDL_SwapLE32(cabecalho[2]) == REDE_OCULTOS &&
+              ler_le16(arquivo, &lida.pesos_entrada[0][0], (size_t)REDE_ENTRADAS * REDE_OCULTOS) &&
+              ler_le16(arquivo, lida.vies_entrada, REDE_OCULTOS) &&
+              SDL_RWread(arquivo, saida, 1, sizeof(saida)) == sizeof(saida) &&
+              SDL_RWread(arquivo, &vies_saida, sizeof(vies_saida), 1) == 1;
+    SDL_RWclose(arquivo);
+    if (!ok) return false;
+
+    for (int j = 0; j < 2 * REDE_OCULTOS; j++) lida.pesos_saida[j] = saida[j];
+    lida.vies_saida = (int32_t)SDL_SwapLE32(vies_saida);
+    *rede = lida;
+    escolher_nucleos();
+    return true;
+}
+
+void rede_aleatoria(RedeNeural* rede, uint64_t semente) {
+    uint64_t rng = semente ? semente : 1;
+    for (int i = 0; i < REDE_ENTRADAS; i++)
+        for (int j = 0; j < REDE_OCULTOS; j++)
+            rede->pesos_entrada[i][j] = (int16_t)((int)(xorshift64(&rng) % 33) - 16);
+    for (int j = 0; j < REDE_OCULTOS; j++) rede->vies_entrada[j] = (int16_t)(xorshift64(&rng) % 64);
+    for (int j = 0; j < 2 * REDE_OCULTOS; j++) rede->pesos_saida[j] = (int16_t)((int)(xorshift64(&rng) % 255) - 127);
+    rede->vies_saida = 0;
+    escolher_nucleos();
+}
+
+/*
+    Índice da característica de uma peça vista da perspectiva `perspectiva`:
+    as casas das próprias peças vêm primeiro, as do adversário depois.
+*/
+static inline int caracteristica(int perspectiva, int dono, int casa) {
+    return (dono == perspectiva ? 0 : TOTAL_CASAS) + casa;
+}
+
+void rede_adicionar_peca(const RedeNeural* rede, Acumulador* acc, int jogador, int casa) {
+    somar_linha(acc->valores[0], rede->pesos_entrada[caracteristica(0, jogador, casa)]);
+    somar_linha(acc->valores[1], rede->pesos_entrada[caracteristica(1, jogador, casa)]);
+}
+
+void rede_remover_peca(const RedeNeural* rede, Acumulador* acc, int jogador, int casa) {
+    subtrair_linha(acc->valores[0], rede->pesos_entrada[caracteristica(0, jogador, casa)]);
+    subtrair_linha(acc->valores[1], rede->pesos_entrada[caracteristica(1, jogador, casa)]);
+}
+
+void rede_acumulador_inicial(const RedeNeural* rede, Acumulador* acc, const Posicao* p) {
+    memcpy(acc->valores[0], rede->vies_entrada, sizeof(rede->vies_entrada));
+    memcpy(acc->valores[1], rede->vies_entrada, sizeof(rede->vies_entrada));
+
+    // Peças do jogador 1 (que joga nas jogadas pares) e do jogador 2
+    uint64_t jogador1 = (p->jogadas % 2 == 0) ? p->atual : pecas_adversario(p);
+    for (int c = 0; c < COLUNAS; c++) {
+        for (int l = 0; l < LINHAS; l++) {
+            uint64_t bit = UINT64_C(1) << (c * ALTURA + l);
+            if (!(p->mascara & bit)) break;
+            rede_adicionar_peca(rede, acc, (jogador1 & bit) ? 0 : 1, c * LINHAS + l);
+        }
+    }
+}
+
+int rede_avaliar(const RedeNeural* rede, const Acumulador* acc, int jogador_vez) {
+    int32_t soma = rede->vies_saida;
+    soma += produto_saida(acc->valores[jogador_vez], rede->pesos_saida);
+    soma += produto_saida(acc->valores[1 - jogador_vez], rede->pesos_saida + REDE_OCULTOS);
+    return soma / REDE_ESCALA_SAIDA;
+}
+
+static double segundos_desde(Uint64 inicio) {
+    return (double)(SDL_GetPerformanceCounter() - inicio) / (double)SDL_GetPerformanceFrequency();
+}
+
+/*
+    Mede três formas de avaliar as mesmas posições: avaliação manual, rede
+    recalculada do zero e rede incremental (jogar, avaliar e desfazer uma peça,
+    que é o custo real dentro da busca).
+*/
+void benchmark_rede(const RedeNeural* rede, int num_posicoes, int repeticoes) {
+    Posicao* posicoes = malloc(sizeof(Posicao) * num_posicoes);
+    int* colunas = malloc(sizeof(int) * num_posicoes);
+    if (!posicoes || !colunas) {
+        free(posicoes);
+        free(colunas);
+        return;
+    }
+
+    uint64_t rng = 2024;
+    for (int n = 0; n < num_posicoes; n++) {
+        Posicao p = {0, 0, 0};
+        int alvo = (int)(xorshift64(&rng) % (TOTAL_CASAS - 8));
+        while (p.jogadas < alvo) {
+            int coluna = (int)(xorshift64(&rng) % COLUNAS);
+            if (!pode_jogar(&p, coluna)) continue;
+            if (jogada_vencedora(&p, coluna)) break;
+            jogar_coluna(&p, coluna);
+        }
+        int coluna;
+        do coluna = (int)(xorshift64(&rng) % COLUNAS); while (!pode_jogar(&p, coluna));
+        posicoes[n] = p;
+        colunas[n] = coluna;
+    }
+
+    double total = (double)num_posicoes * repeticoes;
+    volatile int soma = 0;
+
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    for (int r = 0; r < repeticoes; r++)
+        for (int n = 0; n < num_posicoes; n++) soma += avaliar_posicao(&posicoes[n]);
+    double manual = total / segundos_desde(inicio);
+
+    Acumulador acc;
+    inicio = SDL_GetPerformanceCounter();
+    for (int r = 0; r < repeticoes; r++) {
+        for (int n = 0; n < num_posicoes; n++) {
+            rede_acumulador_inicial(rede, &acc, &posicoes[n]);
+            soma += rede_avaliar(rede, &acc, posicoes[n].jogadas % 2);
+        }
+    }
+    double completa = total / segundos_desde(inicio);
+
+    Acumulador* accs = malloc(sizeof(Acumulador) * num_posicoes);
+    if (accs) {
+        for (int n = 0; n < num_posicoes; n++) rede_acumulador_inicial(rede, &accs[n], &posicoes[n]);
+        inicio = SDL_GetPerformanceCounter();
+        for (int r = 0; r < repeticoes; r++) {
+            for (int n = 0; n < num_posicoes; n++) {
+                int jogador = posicoes[n].jogadas % 2;
+                int casa = rede_casa_da_jogada(&posicoes[n], colunas[n]);
+                rede_adicionar_peca(rede, &accs[n], jogador, casa);
+                soma += rede_avaliar(rede, &accs[n], 1 - jogador);
+                rede_remover_peca(rede, &accs[n], jogador, casa);
+            }
+        }
+        double incremental = total / segundos_desde(inicio);
+        printf("Rede incremental (%s): %.0f aval/s\n", nome_nucleo, incremental);
+        free(accs);
+    }
+    printf("Rede completa    (%s): %.0f aval/s\n", nome_nucleo, completa);
+    printf("Avaliacao manual:         %.0f aval/s\n", manual);
+
+    free(posicoes);
+    free(colunas);
+}
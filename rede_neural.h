@@ -0,0 +1,72 @@
+/*
+    Avaliador opcional por rede neural quantizada (somente CPU).
+
+    Entrada: 84 características binárias (2 jogadores x 42 casas), vistas da
+    perspectiva de cada jogador ("minhas peças" e "peças dele").
+    Camada oculta: REDE_OCULTOS neurônios em int16, mantidos em acumuladores
+    que são atualizados peça a peça (jogar soma uma linha de pesos, desfazer
+    subtrai), sem recalcular a camada inteira.
+    Saída: ReLU limitada a [0, 127] das duas perspectivas (jogador da vez
+    primeiro) multiplicada por pesos int8, somada em int32.
+
+    Os núcleos de soma e produto escalar têm versões AVX2, SSE2 e escalar,
+    escolhidas em tempo de execução com SDL_cpuinfo.
+*/
+
+#ifndef REDE_NEURAL_H
+#define REDE_NEURAL_H
+
+#include "motor.h"
+
+#define REDE_ENTRADAS (2 * TOTAL_CASAS) // 84 no tabuleiro 7x6
+#define REDE_OCULTOS 32
+#define REDE_LIMITE_RELU 127            // Teto da ativação quantizada
+#define REDE_ESCALA_SAIDA (64 / ESCALA_PESOS) // Divisor que traz a saída para a escala da avaliação manual
+
+struct RedeNeural {
+    int16_t pesos_entrada[REDE_ENTRADAS][REDE_OCULTOS];
+    int16_t vies_entrada[REDE_OCULTOS];
+    int16_t pesos_saida[2 * REDE_OCULTOS]; // Lidos como int8 do arquivo, expandidos para o produto escalar
+    int32_t vies_saida;
+};
+
+// Camada oculta das duas perspectivas: [0] = jogador 1, [1] = jogador 2
+typedef struct {
+    int16_t valores[2][REDE_OCULTOS];
+} Acumulador;
+
+/*
+    Lê os pesos de um arquivo binário (little-endian):
+      "C4RN", uint32 versão (1), uint32 entradas (84), uint32 ocultos (32),
+      int16 pesos_entrada[entradas][ocultos], int16 vies_entrada[ocultos],
+      int8 pesos_saida[2 * ocultos], int32 vies_saida
+    Retorna false se o arquivo não existir, não for compatível ou estiver
+    incompleto; nesse caso a rede fica como estava.
+*/
+bool rede_carregar(RedeNeural* rede, const char* caminho);
+
+// Pesos pseudoaleatórios, para medir desempenho sem um arquivo treinado
+void rede_aleatoria(RedeNeural* rede, uint64_t semente);
+
+// Recalcula o acumulador a partir do zero para a posição
+void rede_acumulador_inicial(const RedeNeural* rede, Acumulador* acc, const Posicao* p);
+
+// Atualização incremental: jogador 0 ou 1 (jogador 1 ou 2 da interface), casa = coluna * LINHAS + linha
+void rede_adicionar_peca(const RedeNeural* rede, Acumulador* acc, int jogador, int casa);
+void rede_remover_peca(const RedeNeural* rede, Acumulador* acc, int jogador, int casa);
+
+// Casa onde cairia a peça jogada na coluna (no formato usado acima)
+static inline int rede_casa_da_jogada(const Posicao* p, int coluna) {
+    return coluna * LINHAS + CONTAR_BITS(p->mascara & mascara_coluna(coluna));
+}
+
+// Pontuação para o jogador da vez (0 ou 1), na mesma escala de avaliar_posicao()
+int rede_avaliar(const RedeNeural* rede, const Acumulador* acc, int jogador_vez);
+
+// Nome do núcleo escolhido ("avx2", "sse2" ou "escalar")
+const char* rede_nucleo(void);
+
+// Compara avaliações por segundo da rede (completa e incremental) com a avaliação manual
+void benchmark_rede(const RedeNeural* rede, int num_posicoes, int repeticoes);
+
+#endif
@@ -0,0 +1,179 @@
+/*
+    Ritmo de quadros e medição de jitter (ver ritmo.h).
+*/
+
+#include "ritmo.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RITMO_PADRAO_FPS 60.0 // Quando o monitor não informa a própria taxa
+
+bool ritmo_interpretar(const char* texto, ModoRitmo* modo, double* quadros_por_segundo) {
+    if (strcmp(texto, "vsync") == 0) {
+        *modo = RITMO_VSYNC;
+        return true;
+    }
+    if (strcmp(texto, "livre") == 0) {
+        *modo = RITMO_LIVRE;
+        return true;
+    }
+    double fps = atof(texto);
+    if (fps <= 0) return false;
+    *modo = RITMO_LIMITADO;
+    *quadros_por_segundo = fps;
+    return true;
+}
+
+static void definir_taxa(RitmoQuadros* ritmo, double quadros_por_segundo) {
+    if (quadros_por_segundo <= 0) quadros_por_segundo = RITMO_PADRAO_FPS;
+    ritmo->quadros_por_segundo = quadros_por_segundo;
+    ritmo->periodo = (Uint64)((double)SDL_GetPerformanceFrequency() / quadros_por_segundo);
+}
+
+void ritmo_iniciar(RitmoQuadros* ritmo, ModoRitmo modo, double quadros_por_segundo) {
+    memset(ritmo, 0, sizeof(*ritmo));
+    ritmo->modo = modo;
+    definir_taxa(ritmo, quadros_por_segundo);
+}
+
+Uint32 ritmo_flags_renderizador(const RitmoQuadros* ritmo) {
+    return ritmo->modo == RITMO_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+}
+
+void ritmo_configurar(RitmoQuadros* ritmo, SDL_Window* janela, SDL_Renderer* renderer) {
+    if (ritmo->modo != RITMO_VSYNC) return;
+    SDL_DisplayMode modo_tela;
+    double taxa_monitor = 0;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(janela), &modo_tela) == 0)
+        taxa_monitor = modo_tela.refresh_rate;
+    definir_taxa(ritmo, taxa_monitor);
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && !(info.flags & SDL_RENDERER_PRESENTVSYNC)) {
+        SDL_Log("Ritmo: renderizador sem VSync, limitando a %.0f quadros/s", ritmo->quadros_por_segundo);
+        ritmo->modo = RITMO_LIMITADO;
+    }
+}
+
+int ritmo_espera_ms(const RitmoQuadros* ritmo) {
+    if (ritmo->modo != RITMO_LIMITADO || !ritmo->em_sequencia) return 0;
+    Uint64 agora = SDL_GetPerformanceCounter();
+    if (agora >= ritmo->prazo) return 0;
+    double ms = (double)(ritmo->prazo - agora) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return ms > RITMO_MARGEM_GIRO_MS ? (int)ms - RITMO_MARGEM_GIRO_MS : 0;
+}
+
+void ritmo_aguardar(RitmoQuadros* ritmo) {
+    if (ritmo->modo != RITMO_LIMITADO || !ritmo->em_sequencia) return;
+    int dormir = ritmo_espera_ms(ritmo);
+    if (dormir > 0) SDL_Delay((Uint32)dormir);
+    while (SDL_GetPerformanceCounter() < ritmo->prazo) {
+        // Giro curto até o prazo: SDL_Delay não tem precisão abaixo de ~1 ms
+    }
+}
+
+void ritmo_quadro_apresentado(RitmoQuadros* ritmo, bool animando) {
+    Uint64 agora = SDL_GetPerformanceCounter();
+    if (ritmo->em_sequencia && animando) {
+        double ms = (double)(agora - ritmo->ultimo_quadro) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        ritmo->intervalos_ms[ritmo->num_intervalos % RITMO_AMOSTRAS] = (float)ms;
+        ritmo->num_intervalos++;
+    }
+    // Prazo do próximo quadro; depois de um atraso maior que um quadro, recomeça de agora em vez de tentar recuperar
+    if (!ritmo->em_sequencia || agora > ritmo->prazo + ritmo->periodo) ritmo->prazo = agora + ritmo->periodo;
+    else ritmo->prazo += ritmo->periodo;
+    ritmo->ultimo_quadro = agora;
+    ritmo->em_sequencia = animando;
+}
+
+static int comparar_float(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+bool ritmo_estatisticas(const RitmoQuadros* ritmo, EstatisticasRitmo* e) {
+    memset(e, 0, sizeof(*e));
+    int n = ritmo->num_intervalos < RITMO_AMOSTRAS ? ritmo->num_intervalos : RITMO_AMOSTRAS;
+    if (n == 0) return false;
+    float ordenados[RITMO_AMOSTRAS];
+    memcpy(ordenados, ritmo->intervalos_ms, (size_t)n * sizeof(float));
+    qsort(ordenados, (size_t)n, sizeof(float), comparar_float);
+
+    e->amostras = n;
+    e->alvo_ms = ritmo->modo == RITMO_LIVRE ? 0.0 : 1000.0 / ritmo->quadros_por_segundo;
+    double soma = 0, soma_quadrados = 0;
+    for (int i = 0; i < n; i++) {
+        soma += ordenados[i];
+        soma_quadrados += (double)ordenados[i] * ordenados[i];
+        if (e->alvo_ms > 0 && ordenados[i] > 1.5 * e->alvo_ms) e->atrasados++;
+    }
+    e->medio_ms = soma / n;
+    double variancia = soma_quadrados / n - e->medio_ms * e->medio_ms;
+    e->jitter_ms = variancia > 0 ? sqrt(variancia) : 0.0;
+    e->p99_ms = ordenados[(n * 99) / 100];
+    e->pior_ms = ordenados[n - 1];
+    return true;
+}
+
+void ritmo_registrar(const RitmoQuadros* ritmo) {
+    static const char* const nomes[] = {"vsync", "limitado", "livre"};
+    EstatisticasRitmo e;
+    if (!ritmo_estatisticas(ritmo, &e)) return;
+    SDL_Log("Ritmo %s: %d intervalos, medio %.2f ms (alvo %.2f), jitter %.3f ms, p99 %.2f ms, pior %.2f ms, %d atrasados",
+            nomes[ritmo->modo], e.amostras, e.medio_ms, e.alvo_ms, e.jitter_ms, e.p99_ms, e.pior_ms, e.atrasados);
+}
+
+void benchmark_ritmo(ModoRitmo modo, double quadros_por_segundo, double segundos) {
+    SDL_Init(SDL_INIT_VIDEO);
+    RitmoQuadros ritmo;
+    ritmo_iniciar(&ritmo, modo, quadros_por_segundo);
+    SDL_Window* janela = SDL_CreateWindow("Connect Four - ritmo", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                          900, 614, SDL_WINDOW_SHOWN);
+    SDL_Renderer* renderer = janela ? SDL_CreateRenderer(janela, -1, ritmo_flags_renderizador(&ritmo)) : NULL;
+    if (!renderer) {
+        printf("Nao foi possivel criar a janela: %s\n", SDL_GetError());
+        if (janela) SDL_DestroyWindow(janela);
+        SDL_Quit();
+        return;
+    }
+    ritmo_configurar(&ritmo, janela, renderer);
+
+    // Um quadrado atravessando a janela a velocidade constante: tremidas ficam visíveis
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    Uint64 uso_cpu = 0; // Tempo fora de SDL_Delay e do Present (aproximação do custo em CPU)
+    bool sair = false;
+    while (!sair && (double)(SDL_GetPerformanceCounter() - inicio) / frequencia < segundos) {
+        SDL_Event evento;
+        while (SDL_PollEvent(&evento))
+            if (evento.type == SDL_QUIT) sair = true;
+        ritmo_aguardar(&ritmo);
+
+        Uint64 antes = SDL_GetPerformanceCounter();
+        double t = (double)(antes - inicio) / frequencia;
+        SDL_Rect quadrado = {(int)fmod(t * 400.0, 900.0), 280, 50, 50};
+        SDL_SetRenderDrawColor(renderer, 255, 230, 200, 255);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, 200, 30, 30, 255);
+        SDL_RenderFillRect(renderer, &quadrado);
+        uso_cpu += SDL_GetPerformanceCounter() - antes;
+        SDL_RenderPresent(renderer);
+        ritmo_quadro_apresentado(&ritmo, true);
+    }
+
+    static const char* const nomes[] = {"vsync", "limitado", "livre"};
+    EstatisticasRitmo e;
+    if (ritmo_estatisticas(&ritmo, &e)) {
+        double total = (double)(SDL_GetPerformanceCounter() - inicio) / frequencia;
+        printf("Modo %s (%.1f quadros/s de alvo): %d intervalos\n", nomes[ritmo.modo],
+               ritmo.modo == RITMO_LIVRE ? 0.0 : ritmo.quadros_por_segundo, e.amostras);
+        printf("  medio %.3f ms, jitter (desvio padrao) %.3f ms, p99 %.3f ms, pior %.3f ms, %d atrasados\n",
+               e.medio_ms, e.jitter_ms, e.p99_ms, e.pior_ms, e.atrasados);
+        printf("  desenho %.1f%% do tempo (o resto e espera)\n", total > 0 ? 100.0 * (double)uso_cpu / frequencia / total : 0.0);
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(janela);
+    SDL_Quit();
+}
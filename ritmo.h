@@ -0,0 +1,87 @@
+/*
+    Ritmo de quadros (frame pacing) e medição de jitter.
+
+    Três modos de apresentação:
+    - RITMO_VSYNC:    SDL_RenderPresent espera o retraço vertical do monitor;
+    - RITMO_LIMITADO: no máximo N quadros por segundo; o laço dorme com
+                      SDL_Delay até perto do prazo do quadro e gasta só os
+                      últimos RITMO_MARGEM_GIRO_MS girando no contador de
+                      alta resolução, para acertar o prazo sem o atraso do
+                      escalonador;
+    - RITMO_LIVRE:    sem limite (para benchmarks).
+
+    O ritmo só vale enquanto há animação: parado, o jogo dorme esperando
+    eventos (ver o laço principal em Conecta4.c). Os intervalos entre
+    quadros seguidos de animação são guardados para medir o jitter.
+*/
+
+#ifndef RITMO_H
+#define RITMO_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define RITMO_MARGEM_GIRO_MS 2 // Fim da espera feito girando, em vez de dormir
+#define RITMO_AMOSTRAS 4096    // Intervalos guardados para as estatísticas (os mais recentes)
+
+typedef enum { RITMO_VSYNC, RITMO_LIMITADO, RITMO_LIVRE } ModoRitmo;
+
+typedef struct {
+    ModoRitmo modo;
+    double quadros_por_segundo;  // Meta do modo limitado; no VSync, a taxa do monitor
+    Uint64 periodo;              // Duração de um quadro em unidades do contador de performance
+    Uint64 prazo;                // Quando o próximo quadro deve ser apresentado (modo limitado)
+    Uint64 ultimo_quadro;        // Contador no último SDL_RenderPresent
+    bool em_sequencia;           // O último quadro fazia parte de uma animação contínua
+    float intervalos_ms[RITMO_AMOSTRAS];
+    int num_intervalos;          // Total medido (as amostras circulam depois de RITMO_AMOSTRAS)
+} RitmoQuadros;
+
+typedef struct {
+    int amostras;
+    double alvo_ms;              // Intervalo esperado pelo modo (0 no modo livre)
+    double medio_ms;
+    double jitter_ms;            // Desvio padrão dos intervalos
+    double p99_ms;
+    double pior_ms;
+    int atrasados;               // Intervalos acima de 1,5 vez o alvo (quadros perdidos)
+} EstatisticasRitmo;
+
+// Interpreta "vsync", "livre" ou um número de quadros por segundo
+bool ritmo_interpretar(const char* texto, ModoRitmo* modo, double* quadros_por_segundo);
+
+void ritmo_iniciar(RitmoQuadros* ritmo, ModoRitmo modo, double quadros_por_segundo);
+
+// Flags para SDL_CreateRenderer conforme o modo
+Uint32 ritmo_flags_renderizador(const RitmoQuadros* ritmo);
+
+/*
+    Depois de criar o renderizador: confere se o VSync foi mesmo ativado
+    (senão passa a limitar à taxa do monitor) e usa a taxa do monitor como
+    alvo do modo VSync.
+*/
+void ritmo_configurar(RitmoQuadros* ritmo, SDL_Window* janela, SDL_Renderer* renderer);
+
+// Quanto o laço pode dormir esperando eventos antes do próximo quadro de animação (ms)
+int ritmo_espera_ms(const RitmoQuadros* ritmo);
+
+// Modo limitado: espera até o prazo do próximo quadro (dorme e gira no fim); nos outros modos retorna na hora
+void ritmo_aguardar(RitmoQuadros* ritmo);
+
+/*
+    Chamada logo depois de SDL_RenderPresent. `animando` diz se o quadro faz
+    parte de uma animação contínua; só intervalos entre dois quadros assim
+    entram na medição, e o primeiro quadro de uma sequência reinicia os prazos.
+*/
+void ritmo_quadro_apresentado(RitmoQuadros* ritmo, bool animando);
+
+// Estatísticas dos intervalos medidos; false se ainda não há amostras
+bool ritmo_estatisticas(const RitmoQuadros* ritmo, EstatisticasRitmo* e);
+
+// Escreve as estatísticas no log (nada se não houver amostras)
+void ritmo_registrar(const RitmoQuadros* ritmo);
+
+// Anima um quadrado em uma janela por `segundos` segundos no modo pedido e mostra o jitter
+void benchmark_ritmo(ModoRitmo modo, double quadros_por_segundo, double segundos);
+
+#endif
@@ -0,0 +1,253 @@
+/*
+    Atlas de sprites e desenho em lote (ver sprites.h).
+*/
+
+#include "sprites.h"
+
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ESPACO_ATLAS 2 // Pixels transparentes entre sprites, para a filtragem não misturar vizinhos
+
+// Arquivo de cada sprite, na ordem do enum
+static const char* const arquivos_sprites[NUM_SPRITES] = {
+    "imagens1/ficha_vermelha.png",
+    "imagens1/ficha_amarela.png",
+    "imagens1/jogo_tabuleiro.png",
+};
+
+bool atlas_criar(AtlasSprites* atlas, SDL_Renderer* renderer) {
+    memset(atlas, 0, sizeof(*atlas));
+    SDL_Surface* imagens[NUM_SPRITES] = {NULL};
+    bool ok = true;
+
+    // Sprites em uma fileira só, da esquerda para a direita
+    int largura = 0, altura = 0;
+    for (int i = 0; i < NUM_SPRITES; i++) {
+        imagens[i] = IMG_Load(arquivos_sprites[i]);
+        if (!imagens[i]) {
+            SDL_Log("Atlas: nao foi possivel carregar %s", arquivos_sprites[i]);
+            ok = false;
+            continue;
+        }
+        atlas->recortes[i] = (SDL_Rect){largura, 0, imagens[i]->w, imagens[i]->h};
+        largura += imagens[i]->w + ESPACO_ATLAS;
+        if (imagens[i]->h > altura) altura = imagens[i]->h;
+    }
+
+    SDL_Surface* folha = ok ? SDL_CreateRGBSurfaceWithFormat(0, largura, altura, 32, SDL_PIXELFORMAT_RGBA32) : NULL;
+    if (folha) {
+        // Sem mistura: copia o alfa das imagens como está (a folha nova é toda transparente)
+        for (int i = 0; i < NUM_SPRITES; i++) {
+            SDL_SetSurfaceBlendMode(imagens[i], SDL_BLENDMODE_NONE);
+            SDL_Rect destino = atlas->recortes[i];
+            SDL_BlitSurface(imagens[i], NULL, folha, &destino);
+        }
+        atlas->textura = SDL_CreateTextureFromSurface(renderer, folha);
+        if (atlas->textura) SDL_SetTextureBlendMode(atlas->textura, SDL_BLENDMODE_BLEND);
+        atlas->largura = largura;
+        atlas->altura = altura;
+        SDL_FreeSurface(folha);
+    }
+    for (int i = 0; i < NUM_SPRITES; i++)
+        if (imagens[i]) SDL_FreeSurface(imagens[i]);
+    return atlas->textura != NULL;
+}
+
+void atlas_destruir(AtlasSprites* atlas) {
+    if (atlas->textura) SDL_DestroyTexture(atlas->textura);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+bool lote_criar(LoteSprites* lote, int capacidade) {
+    lote->vertices = malloc((size_t)capacidade * 4 * sizeof(SDL_Vertex));
+    lote->indices = malloc((size_t)capacidade * 6 * sizeof(int));
+    lote->num_sprites = 0;
+    lote->capacidade = lote->vertices && lote->indices ? capacidade : 0;
+    return lote->capacidade > 0;
+}
+
+void lote_destruir(LoteSprites* lote) {
+    free(lote->vertices);
+    free(lote->indices);
+    memset(lote, 0, sizeof(*lote));
+}
+
+void lote_limpar(LoteSprites* lote) {
+    lote->num_sprites = 0;
+}
+
+void lote_adicionar(LoteSprites* lote, const AtlasSprites* atlas, int sprite, const SDL_FRect* destino) {
+    const SDL_FRect inteiro = {0, 0, 1, 1};
+    lote_adicionar_parte(lote, atlas, sprite, &inteiro, destino);
+}
+
+void lote_adicionar_parte(LoteSprites* lote, const AtlasSprites* atlas, int sprite, const SDL_FRect* parte,
+                          const SDL_FRect* destino) {
+    if (lote->num_sprites >= lote->capacidade || !atlas->textura) return;
+    const SDL_Rect* r = &atlas->recortes[sprite];
+    float x_ini = (float)r->x + parte->x * (float)r->w, x_fim = x_ini + parte->w * (float)r->w;
+    float y_ini = (float)r->y + parte->y * (float)r->h, y_fim = y_ini + parte->h * (float)r->h;
+    float u0 = x_ini / (float)atlas->largura, u1 = x_fim / (float)atlas->largura;
+    float v0 = y_ini / (float)atlas->altura, v1 = y_fim / (float)atlas->altura;
+    float x0 = destino->x, x1 = destino->x + destino->w;
+    float y0 = destino->y, y1 = destino->y + destino->h;
+
+    // Cantos em sentido horário a partir do superior esquerdo; dois triângulos por retângulo
+    int base = lote->num_sprites * 4;
+    SDL_Vertex* v = &lote->vertices[base];
+    SDL_Color branco = {255, 255, 255, 255};
+    v[0] = (SDL_Vertex){{x0, y0}, branco, {u0, v0}};
+    v[1] = (SDL_Vertex){{x1, y0}, branco, {u1, v0}};
+    v[2] = (SDL_Vertex){{x1, y1}, branco, {u1, v1}};
+    v[3] = (SDL_Vertex){{x0, y1}, branco, {u0, v1}};
+    int* indice = &lote->indices[lote->num_sprites * 6];
+    indice[0] = base;
+    indice[1] = base + 1;
+    indice[2] = base + 2;
+    indice[3] = base;
+    indice[4] = base + 2;
+    indice[5] = base + 3;
+    lote->num_sprites++;
+}
+
+int lote_desenhar(SDL_Renderer* renderer, const LoteSprites* lote, const AtlasSprites* atlas) {
+    if (lote->num_sprites == 0 || !atlas->textura) return 0;
+    if (SDL_RenderGeometry(renderer, atlas->textura, lote->vertices, lote->num_sprites * 4, lote->indices,
+                           lote->num_sprites * 6) == 0)
+        return 1;
+
+    // Renderizador sem geometria: um retângulo por vez, recortado do atlas pelas coordenadas de textura
+    for (int i = 0; i < lote->num_sprites; i++) {
+        const SDL_Vertex* v = &lote->vertices[i * 4];
+        SDL_Rect origem = {
+            (int)(v[0].tex_coord.x * (float)atlas->largura + 0.5f),
+            (int)(v[0].tex_coord.y * (float)atlas->altura + 0.5f),
+            (int)((v[2].tex_coord.x - v[0].tex_coord.x) * (float)atlas->largura + 0.5f),
+            (int)((v[2].tex_coord.y - v[0].tex_coord.y) * (float)atlas->altura + 0.5f)
+        };
+        SDL_FRect destino = {v[0].position.x, v[0].position.y, v[2].position.x - v[0].position.x,
+                             v[2].position.y - v[0].position.y};
+        SDL_RenderCopyF(renderer, atlas->textura, &origem, &destino);
+    }
+    return lote->num_sprites;
+}
+
+/*
+    Benchmark
+*/
+
+typedef struct {
+    SDL_FRect destino;
+    float vx, vy;
+} SpriteTeste;
+
+// Move os sprites e os faz quicar nas bordas da janela (como MoveSprites do testsprite2)
+static void mover_sprites(SpriteTeste* sprites, int n, int largura, int altura) {
+    for (int i = 0; i < n; i++) {
+        SDL_FRect* d = &sprites[i].destino;
+        d->x += sprites[i].vx;
+        d->y += sprites[i].vy;
+        if (d->x < 0 || d->x + d->w > (float)largura) {
+            sprites[i].vx = -sprites[i].vx;
+            d->x += sprites[i].vx;
+        }
+        if (d->y < 0 || d->y + d->h > (float)altura) {
+            sprites[i].vy = -sprites[i].vy;
+            d->y += sprites[i].vy;
+        }
+    }
+}
+
+void benchmark_sprites(int num_sprites, double segundos) {
+    if (num_sprites < 1) num_sprites = 1;
+    SDL_Init(SDL_INIT_VIDEO);
+    IMG_Init(IMG_INIT_PNG);
+    int largura = 900, altura = 614;
+    SDL_Window* janela = SDL_CreateWindow("Connect Four - sprites", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                          largura, altura, SDL_WINDOW_SHOWN);
+    SDL_Renderer* renderer = janela ? SDL_CreateRenderer(janela, -1, 0) : NULL; // Sem VSync: mede o custo real
+    AtlasSprites atlas = {0};
+    LoteSprites lote = {0};
+    SpriteTeste* sprites = malloc((size_t)num_sprites * sizeof(SpriteTeste));
+    SDL_Texture* texturas[NUM_FICHAS] = {NULL};
+    if (!renderer || !sprites || !atlas_criar(&atlas, renderer) || !lote_criar(&lote, num_sprites)) {
+        printf("Nao foi possivel preparar o benchmark de sprites: %s\n", SDL_GetError());
+        lote_destruir(&lote);
+        atlas_destruir(&atlas);
+        free(sprites);
+        if (renderer) SDL_DestroyRenderer(renderer);
+        if (janela) SDL_DestroyWindow(janela);
+        IMG_Quit();
+        SDL_Quit();
+        return;
+    }
+    for (int i = 0; i < NUM_FICHAS; i++) texturas[i] = IMG_LoadTexture(renderer, arquivos_sprites[i]);
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo(renderer, &info);
+    printf("Renderizador %s, %d sprites, %.1f s por modo\n", info.name, num_sprites, segundos);
+
+    static const char* const nomes[] = {"uma a uma", "lote"};
+    double frequencia = (double)SDL_GetPerformanceFrequency();
+    for (int modo = 0; modo < 2; modo++) {
+        // Mesmas posições e velocidades iniciais nos dois modos
+        srand(1);
+        for (int i = 0; i < num_sprites; i++) {
+            float w = (float)atlas.recortes[0].w, h = (float)atlas.recortes[0].h;
+            sprites[i].destino = (SDL_FRect){(float)(rand() % (largura - (int)w)), (float)(rand() % (altura - (int)h)), w, h};
+            do {
+                sprites[i].vx = (float)(rand() % 5 - 2);
+                sprites[i].vy = (float)(rand() % 5 - 2);
+            } while (sprites[i].vx == 0 && sprites[i].vy == 0);
+        }
+
+        uint64_t quadros = 0, chamadas = 0;
+        double pior_ms = 0;
+        Uint64 inicio = SDL_GetPerformanceCounter(), anterior = inicio;
+        bool sair = false;
+        while (!sair && (double)(anterior - inicio) / frequencia < segundos) {
+            SDL_Event evento;
+            while (SDL_PollEvent(&evento))
+                if (evento.type == SDL_QUIT) sair = true;
+
+            mover_sprites(sprites, num_sprites, largura, altura);
+            SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
+            SDL_RenderClear(renderer);
+            if (modo == 0) {
+                // Cores alternadas: cada cópia troca de textura
+                for (int i = 0; i < num_sprites; i++) {
+                    SDL_RenderCopyF(renderer, texturas[i % NUM_FICHAS], NULL, &sprites[i].destino);
+                    chamadas++;
+                }
+            } else {
+                lote_limpar(&lote);
+                for (int i = 0; i < num_sprites; i++) lote_adicionar(&lote, &atlas, i % NUM_FICHAS, &sprites[i].destino);
+                chamadas += (uint64_t)lote_desenhar(renderer, &lote, &atlas);
+            }
+            SDL_RenderPresent(renderer);
+
+            Uint64 agora = SDL_GetPerformanceCounter();
+            double ms = (double)(agora - anterior) * 1000.0 / frequencia;
+            if (ms > pior_ms) pior_ms = ms;
+            anterior = agora;
+            quadros++;
+        }
+        double total = (double)(anterior - inicio) / frequencia;
+        printf("%-10s %8.1f quadros/s, quadro medio %.3f ms, pior %.3f ms, %.1f chamadas de desenho por quadro\n",
+               nomes[modo], total > 0 ? (double)quadros / total : 0.0, quadros ? total * 1000.0 / (double)quadros : 0.0,
+               pior_ms, quadros ? (double)chamadas / (double)quadros : 0.0);
+        if (sair) break;
+    }
+
+    for (int i = 0; i < NUM_FICHAS; i++)
+        if (texturas[i]) SDL_DestroyTexture(texturas[i]);
+    lote_destruir(&lote);
+    atlas_destruir(&atlas);
+    free(sprites);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(janela);
+    IMG_Quit();
+    SDL_Quit();
+}
@@ -0,0 +1,67 @@
+/*
+    Atlas de sprites e desenho em lote.
+
+    As imagens do jogo desenhadas muitas vezes por quadro (as duas fichas e,
+    para o modo espectador, o tabuleiro) ficam lado a lado em uma única
+    textura, o atlas. Os sprites de um quadro entram em um
+    lote de vértices e índices (4 vértices e 6 índices por retângulo) e saem
+    em uma única chamada a SDL_RenderGeometry, sem trocar de textura entre
+    uma ficha e outra. Para um sprite novo, basta acrescentar o arquivo em
+    sprites.c e o nome no enum abaixo.
+*/
+
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+enum { SPRITE_FICHA_VERMELHA, SPRITE_FICHA_AMARELA, SPRITE_TABULEIRO, NUM_SPRITES };
+#define NUM_FICHAS 2 // Os primeiros sprites são as fichas
+
+typedef struct {
+    SDL_Texture* textura;
+    SDL_Rect recortes[NUM_SPRITES]; // Região de cada sprite dentro do atlas
+    int largura, altura;
+} AtlasSprites;
+
+typedef struct {
+    SDL_Vertex* vertices;
+    int* indices;
+    int num_sprites;
+    int capacidade;
+} LoteSprites;
+
+// Carrega as imagens dos sprites e monta o atlas; retorna false se alguma faltar
+bool atlas_criar(AtlasSprites* atlas, SDL_Renderer* renderer);
+void atlas_destruir(AtlasSprites* atlas);
+
+bool lote_criar(LoteSprites* lote, int capacidade);
+void lote_destruir(LoteSprites* lote);
+
+// Esvazia o lote para o próximo quadro
+void lote_limpar(LoteSprites* lote);
+
+// Acrescenta um sprite do atlas no retângulo de destino (ignorado se o lote estiver cheio)
+void lote_adicionar(LoteSprites* lote, const AtlasSprites* atlas, int sprite, const SDL_FRect* destino);
+
+// Como lote_adicionar, mas só com a parte do sprite em `parte` (frações da largura e da altura dele)
+void lote_adicionar_parte(LoteSprites* lote, const AtlasSprites* atlas, int sprite, const SDL_FRect* parte,
+                          const SDL_FRect* destino);
+
+/*
+    Desenha o lote inteiro e retorna quantas chamadas de desenho foram
+    feitas: 1 com SDL_RenderGeometry, ou uma por sprite se o renderizador
+    não aceitar geometria.
+*/
+int lote_desenhar(SDL_Renderer* renderer, const LoteSprites* lote, const AtlasSprites* atlas);
+
+/*
+    Como o testsprite2 da SDL: `num_sprites` fichas quicando na janela,
+    desenhadas por `segundos` segundos uma a uma (SDL_RenderCopy com a
+    textura de cada cor) e depois em lote. Mostra quadros por segundo, tempo
+    médio de quadro e chamadas de desenho por quadro.
+*/
+void benchmark_sprites(int num_sprites, double segundos);
+
+#endif
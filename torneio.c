@@ -0,0 +1,141 @@
+/*
+    Torneio de autojogo para o modo espectador (ver torneio.h).
+*/
+
+#include "torneio.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "playout.h" // xorshift64
+
+#define TORNEIO_ESPERA_OCIOSA_MS 10 // Pausa de uma thread cujas partidas estão todas encerradas
+
+// Avisa o espectador, a menos que um aviso anterior ainda não tenha sido lido
+static void avisar(Torneio* t) {
+    if (t->evento_mudanca == (Uint32)-1 || !SDL_AtomicCAS(&t->aviso_pendente, 0, 1)) return;
+    SDL_Event aviso;
+    SDL_zero(aviso);
+    aviso.type = t->evento_mudanca;
+    SDL_PushEvent(&aviso);
+}
+
+/*
+    Joga um lance na partida (ou a recomeça, se já terminou e a pausa
+    passou). Retorna false se não havia nada a fazer.
+*/
+static bool avancar_partida(Torneio* t, PartidaTorneio* partida, TabelaTransposicao* tt) {
+    if (partida->resultado != PARTIDA_EM_ANDAMENTO) {
+        if (!SDL_TICKS_PASSED(SDL_GetTicks(), partida->fim + TORNEIO_PAUSA_FINAL_MS)) return false;
+        partida->posicao = (Posicao){0, 0, 0};
+        SDL_AtomicLock(&partida->trava);
+        memset(partida->casas, 0, sizeof(partida->casas));
+        partida->resultado = PARTIDA_EM_ANDAMENTO;
+        partida->versao++;
+        SDL_AtomicUnlock(&partida->trava);
+        avisar(t);
+        return true;
+    }
+
+    Posicao* p = &partida->posicao;
+    int coluna;
+    if (p->jogadas < TORNEIO_JOGADAS_ALEATORIAS) {
+        do coluna = (int)(xorshift64(&partida->rng) % COLUNAS); while (!pode_jogar(p, coluna));
+    } else {
+        coluna = buscar_jogada_com_prazo(p, TOTAL_CASAS, t->ms_por_jogada, tt, &t->parar).coluna;
+    }
+    if (coluna < 0) return false;
+
+    // Só esta thread escreve nas casas: a leitura para achar a linha dispensa a trava
+    int linha = LINHAS - 1;
+    while (linha >= 0 && partida->casas[linha][coluna] != 0) linha--;
+    int jogador = p->jogadas % 2 == 0 ? 1 : 2;
+    ResultadoPartida resultado = PARTIDA_EM_ANDAMENTO;
+    if (jogada_vencedora(p, coluna)) resultado = jogador == 1 ? PARTIDA_VERMELHO : PARTIDA_AMARELO;
+    jogar_coluna(p, coluna);
+    if (resultado == PARTIDA_EM_ANDAMENTO && p->jogadas == TOTAL_CASAS) resultado = PARTIDA_EMPATE;
+
+    SDL_AtomicLock(&partida->trava);
+    partida->casas[linha][coluna] = jogador;
+    partida->resultado = resultado;
+    partida->versao++;
+    SDL_AtomicUnlock(&partida->trava);
+
+    if (resultado != PARTIDA_EM_ANDAMENTO) {
+        partida->fim = SDL_GetTicks();
+        SDL_AtomicAdd(&t->placar[resultado], 1);
+    }
+    avisar(t);
+    return true;
+}
+
+// Corpo de cada thread: um lance por vez em cada uma das suas partidas, até o pedido de parada
+static int thread_torneio(void* dados) {
+    TarefaTorneio* tarefa = dados;
+    Torneio* t = tarefa->torneio;
+    TabelaTransposicao tt;
+    if (!tt_criar(&tt, TORNEIO_TT_MB)) return -1;
+
+    while (!SDL_AtomicGet(&t->parar)) {
+        bool jogou = false;
+        for (int i = tarefa->primeira; i < t->num_partidas && !SDL_AtomicGet(&t->parar); i += t->num_threads)
+            if (avancar_partida(t, &t->partidas[i], &tt)) jogou = true;
+        if (!jogou) SDL_Delay(TORNEIO_ESPERA_OCIOSA_MS);
+    }
+
+    tt_destruir(&tt);
+    return 0;
+}
+
+bool torneio_iniciar(Torneio* torneio, int num_partidas, double ms_por_jogada, Uint32 evento_mudanca) {
+    memset(torneio, 0, sizeof(*torneio));
+    if (num_partidas < 1) num_partidas = 1;
+    if (num_partidas > TORNEIO_MAX_PARTIDAS) num_partidas = TORNEIO_MAX_PARTIDAS;
+    torneio->partidas = calloc((size_t)num_partidas, sizeof(PartidaTorneio));
+    if (!torneio->partidas) return false;
+    torneio->num_partidas = num_partidas;
+    torneio->ms_por_jogada = ms_por_jogada > 0 ? ms_por_jogada : 1; // 0 seria busca sem prazo
+    torneio->evento_mudanca = evento_mudanca;
+    for (int i = 0; i < num_partidas; i++) torneio->partidas[i].rng = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+
+    int num_threads = SDL_GetCPUCount();
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > TORNEIO_MAX_THREADS) num_threads = TORNEIO_MAX_THREADS;
+    if (num_threads > num_partidas) num_threads = num_partidas;
+    torneio->num_threads = num_threads;
+    for (int i = 0; i < num_threads; i++) {
+        torneio->tarefas[i] = (TarefaTorneio){torneio, i};
+        torneio->threads[i] = SDL_CreateThread(thread_torneio, "torneio", &torneio->tarefas[i]);
+        if (!torneio->threads[i]) {
+            torneio_encerrar(torneio);
+            return false;
+        }
+    }
+    return true;
+}
+
+void torneio_encerrar(Torneio* torneio) {
+    SDL_AtomicSet(&torneio->parar, 1);
+    for (int i = 0; i < torneio->num_threads; i++)
+        if (torneio->threads[i]) SDL_WaitThread(torneio->threads[i], NULL);
+    free(torneio->partidas);
+    memset(torneio, 0, sizeof(*torneio));
+}
+
+void torneio_ler_aviso(Torneio* torneio) {
+    SDL_AtomicSet(&torneio->aviso_pendente, 0);
+}
+
+bool torneio_copiar_partida(Torneio* torneio, int indice, int* versao, int casas[LINHAS][COLUNAS],
+                            ResultadoPartida* resultado) {
+    PartidaTorneio* partida = &torneio->partidas[indice];
+    bool copiou = false;
+    SDL_AtomicLock(&partida->trava);
+    if (partida->versao != *versao) {
+        memcpy(casas, partida->casas, sizeof(partida->casas));
+        *resultado = partida->resultado;
+        *versao = partida->versao;
+        copiou = true;
+    }
+    SDL_AtomicUnlock(&partida->trava);
+    return copiou;
+}
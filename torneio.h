@@ -0,0 +1,89 @@
+/*
+    Torneio de autojogo para o modo espectador.
+
+    Várias partidas IA contra IA correm ao mesmo tempo, divididas entre
+    threads (uma por núcleo, cada uma com a sua tabela de transposição e
+    jogando um lance por vez em cada uma das suas partidas). As primeiras
+    TORNEIO_JOGADAS_ALEATORIAS jogadas de cada partida são sorteadas, para as
+    partidas não serem todas iguais; as outras saem da busca com prazo.
+    Uma partida encerrada fica na tela por TORNEIO_PAUSA_FINAL_MS e recomeça.
+
+    O tabuleiro de cada partida é protegido por uma trava curta (spinlock) e
+    tem um número de versão que muda a cada lance, para o espectador copiar
+    e redesenhar só as partidas que mudaram. Quem desenha é avisado por um
+    evento SDL, enviado no máximo uma vez entre duas leituras.
+*/
+
+#ifndef TORNEIO_H
+#define TORNEIO_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "motor.h"
+
+#define TORNEIO_MAX_PARTIDAS 256
+#define TORNEIO_MAX_THREADS 64
+#define TORNEIO_JOGADAS_ALEATORIAS 4   // Abertura sorteada de cada partida
+#define TORNEIO_PAUSA_FINAL_MS 3000    // Tempo que uma partida encerrada fica na tela
+#define TORNEIO_TT_MB 4                // Tabela de transposição de cada thread
+
+typedef enum {
+    PARTIDA_EM_ANDAMENTO,
+    PARTIDA_VERMELHO,   // Vitória do jogador 1
+    PARTIDA_AMARELO,    // Vitória do jogador 2
+    PARTIDA_EMPATE,
+    NUM_RESULTADOS
+} ResultadoPartida;
+
+typedef struct {
+    SDL_SpinLock trava;             // Protege casas, versao e resultado
+    int casas[LINHAS][COLUNAS];     // 0 = vazio, 1 = vermelho, 2 = amarelo (como tabuleiro_virtual)
+    int versao;                     // Muda a cada lance e a cada recomeço
+    ResultadoPartida resultado;
+
+    // Só a thread que joga a partida usa
+    Posicao posicao;
+    uint64_t rng;
+    Uint32 fim;                     // SDL_GetTicks() no fim da partida
+} PartidaTorneio;
+
+typedef struct Torneio Torneio;
+
+typedef struct {
+    Torneio* torneio;
+    int primeira;                   // A thread joga as partidas primeira, primeira + num_threads, ...
+} TarefaTorneio;
+
+struct Torneio {
+    PartidaTorneio* partidas;
+    int num_partidas;
+    double ms_por_jogada;
+    int num_threads;
+    SDL_Thread* threads[TORNEIO_MAX_THREADS];
+    TarefaTorneio tarefas[TORNEIO_MAX_THREADS];
+    SDL_atomic_t parar;
+    SDL_atomic_t aviso_pendente;    // 1 depois de enviar o evento, até o espectador chamar torneio_ler_aviso
+    Uint32 evento_mudanca;          // Evento enviado quando alguma partida muda ((Uint32)-1 = nenhum)
+    SDL_atomic_t placar[NUM_RESULTADOS]; // Partidas encerradas por resultado
+};
+
+/*
+    Cria `num_partidas` partidas (até TORNEIO_MAX_PARTIDAS) e começa a
+    jogá-las com `ms_por_jogada` por lance da busca. Exige motor_inicializar().
+*/
+bool torneio_iniciar(Torneio* torneio, int num_partidas, double ms_por_jogada, Uint32 evento_mudanca);
+
+// Para as threads (espera o lance em andamento de cada uma) e libera as partidas
+void torneio_encerrar(Torneio* torneio);
+
+// Chamada pelo espectador antes de procurar mudanças: mudanças seguintes enviam um novo evento
+void torneio_ler_aviso(Torneio* torneio);
+
+/*
+    Copia o tabuleiro e o resultado da partida `indice` se a versão dela for
+    diferente de *versao (use -1 para forçar a cópia). Retorna true se copiou.
+*/
+bool torneio_copiar_partida(Torneio* torneio, int indice, int* versao, int casas[LINHAS][COLUNAS],
+                            ResultadoPartida* resultado);
+
+#endif
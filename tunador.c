@@ -0,0 +1,273 @@
+/*
+    Tunador dos pesos da avaliação estática (ferramenta de linha de comando).
+
+    1. Joga milhares de partidas rápidas de autojogo (busca rasa com aberturas
+       aleatórias), distribuídas entre todos os núcleos da máquina.
+    2. Guarda as posições "quietas" de cada partida (sem vitória imediata nem
+       bloqueio obrigatório) junto com o resultado final.
+    3. Ajusta os pesos por regressão logística no estilo Texel: minimiza o erro
+       entre sigmoide(K * avaliação) e o resultado, primeiro escolhendo K com
+       os pesos atuais e depois descendo o gradiente, também em paralelo.
+    4. Escreve pesos_avaliacao.h, usado pelo motor na próxima compilação.
+
+    Uso: tunador [partidas] [arquivo_saida]
+*/
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "motor.h"
+#include "playout.h" // xorshift64
+
+#define PARTIDAS_PADRAO 4000
+#define PROFUNDIDADE_AUTOJOGO 4    // Busca rasa: o objetivo é volume de partidas
+#define JOGADAS_ALEATORIAS 8       // Aberturas aleatórias para diversificar as partidas
+#define TT_AUTOJOGO_MB 4           // Tabela de transposição de cada thread
+#define ITERACOES_GRADIENTE 3000
+#define TAXA_APRENDIZADO 2.0
+
+// Posição de treino: características para o jogador da vez e o resultado para ele (1, 0.5 ou 0)
+typedef struct {
+    int8_t carac[NUM_CARACTERISTICAS];
+    float resultado;
+} Amostra;
+
+typedef struct {
+    int num_partidas;
+    uint64_t semente;
+    Amostra* amostras;
+    int num_amostras;
+    int capacidade;
+} TarefaAutojogo;
+
+typedef struct {
+    const Amostra* amostras;
+    int num_amostras;
+    const double* pesos;
+    double k;
+    double gradiente[NUM_CARACTERISTICAS];
+    double erro;
+} TarefaGradiente;
+
+static void adicionar_amostra(TarefaAutojogo* t, const Amostra* a) {
+    if (t->num_amostras == t->capacidade) {
+        int nova = t->capacidade ? t->capacidade * 2 : 4096;
+        Amostra* m = realloc(t->amostras, sizeof(Amostra) * nova);
+        if (!m) return;
+        t->amostras = m;
+        t->capacidade = nova;
+    }
+    t->amostras[t->num_amostras++] = *a;
+}
+
+/*
+    Thread de autojogo: joga t->num_partidas partidas e guarda as amostras.
+*/
+static int thread_autojogo(void* dados) {
+    TarefaAutojogo* t = dados;
+    TabelaTransposicao tt;
+    if (!tt_criar(&tt, TT_AUTOJOGO_MB)) return -1;
+    uint64_t rng = t->semente ? t->semente : 1;
+
+    for (int n = 0; n < t->num_partidas; n++) {
+        Posicao p = {0, 0, 0};
+        Amostra partida[TOTAL_CASAS];
+        int paridade[TOTAL_CASAS];
+        int num = 0;
+        int vencedor = -1; // Paridade das jogadas do vencedor (-1 = empate)
+
+        while (p.jogadas < TOTAL_CASAS) {
+            int coluna;
+            if (p.jogadas < JOGADAS_ALEATORIAS) {
+                do coluna = (int)(xorshift64(&rng) % COLUNAS); while (!pode_jogar(&p, coluna));
+            } else {
+                JogadasForcadas f = analisar_jogadas_forcadas(&p);
+                if (!f.vitorias && !f.bloqueios) {
+                    int c[NUM_CARACTERISTICAS];
+                    caracteristicas_avaliacao(&p, c);
+                    for (int i = 0; i < NUM_CARACTERISTICAS; i++) partida[num].carac[i] = (int8_t)c[i];
+                    paridade[num++] = p.jogadas % 2;
+                }
+                coluna = buscar_jogada(&p, PROFUNDIDADE_AUTOJOGO, &tt).coluna;
+            }
+            if (jogada_vencedora(&p, coluna)) {
+                vencedor = p.jogadas % 2;
+                break;
+            }
+            jogar_coluna(&p, coluna);
+        }
+
+        for (int i = 0; i < num; i++) {
+            partida[i].resultado = vencedor < 0 ? 0.5f : (paridade[i] == vencedor ? 1.0f : 0.0f);
+            adicionar_amostra(t, &partida[i]);
+        }
+    }
+
+    tt_destruir(&tt);
+    return 0;
+}
+
+static inline double sigmoide(double x) {
+    return 1.0 / (1.0 + exp(-x));
+}
+
+/*
+    Thread de gradiente: erro quadrático e seu gradiente sobre uma fatia das amostras.
+*/
+static int thread_gradiente(void* dados) {
+    TarefaGradiente* t = dados;
+    for (int i = 0; i < NUM_CARACTERISTICAS; i++) t->gradiente[i] = 0.0;
+    t->erro = 0.0;
+
+    for (int n = 0; n < t->num_amostras; n++) {
+        const Amostra* a = &t->amostras[n];
+        double aval = 0.0;
+        for (int i = 0; i < NUM_CARACTERISTICAS; i++) aval += t->pesos[i] * a->carac[i];
+        double s = sigmoide(t->k * aval);
+        double diff = s - a->resultado;
+        t->erro += diff * diff;
+        double d = 2.0 * diff * s * (1.0 - s) * t->k;
+        for (int i = 0; i < NUM_CARACTERISTICAS; i++) t->gradiente[i] += d * a->carac[i];
+    }
+    return 0;
+}
+
+/*
+    Divide as amostras entre as threads e soma os resultados parciais.
+    Retorna o erro médio e preenche o gradiente médio.
+*/
+static double calcular_gradiente(const Amostra* amostras, int num_amostras, const double* pesos, double k,
+                                 int num_threads, double gradiente[NUM_CARACTERISTICAS]) {
+    TarefaGradiente tarefas[64];
+    SDL_Thread* threads[64];
+    int fatia = (num_amostras + num_threads - 1) / num_threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        int inicio = t * fatia;
+        int fim = inicio + fatia > num_amostras ? num_amostras : inicio + fatia;
+        tarefas[t].amostras = amostras + inicio;
+        tarefas[t].num_amostras = fim > inicio ? fim - inicio : 0;
+        tarefas[t].pesos = pesos;
+        tarefas[t].k = k;
+        threads[t] = SDL_CreateThread(thread_gradiente, "gradiente", &tarefas[t]);
+        if (!threads[t]) thread_gradiente(&tarefas[t]);
+    }
+
+    double erro = 0.0;
+    for (int i = 0; i < NUM_CARACTERISTICAS; i++) gradiente[i] = 0.0;
+    for (int t = 0; t < num_threads; t++) {
+        if (threads[t]) SDL_WaitThread(threads[t], NULL);
+        erro += tarefas[t].erro;
+        for (int i = 0; i < NUM_CARACTERISTICAS; i++) gradiente[i] += tarefas[t].gradiente[i];
+    }
+    for (int i = 0; i < NUM_CARACTERISTICAS; i++) gradiente[i] /= num_amostras;
+    return erro / num_amostras;
+}
+
+/*
+    Escolhe a escala K da sigmoide que melhor explica os resultados com os
+    pesos atuais, mantendo os pesos ajustados na mesma escala da avaliação.
+*/
+static double ajustar_escala(const Amostra* amostras, int num_amostras, const double* pesos, int num_threads) {
+    double gradiente[NUM_CARACTERISTICAS];
+    double melhor_k = 0.1, melhor_erro = 1e30;
+    for (double k = 0.005; k <= 1.0; k *= 1.1) {
+        double erro = calcular_gradiente(amostras, num_amostras, pesos, k, num_threads, gradiente);
+        if (erro < melhor_erro) {
+            melhor_erro = erro;
+            melhor_k = k;
+        }
+    }
+    return melhor_k;
+}
+
+static bool escrever_pesos(const char* caminho, const double* pesos, int num_partidas, int num_amostras, double erro) {
+    FILE* f = fopen(caminho, "w");
+    if (!f) return false;
+    fprintf(f,
+            "/*\n"
+            "    Pesos da avaliação estática (pontos por janela aberta, do ponto de vista\n"
+            "    do jogador da vez), em 1/ESCALA_PESOS de ponto (ver motor.h).\n"
+            "\n"
+            "    Arquivo gerado pelo tunador (tunador.c) a partir de partidas de autojogo;\n"
+            "    rode o tunador de novo em vez de editar à mão.\n"
+            "    Última geração: %d partidas, %d posições, erro médio %.5f.\n"
+            "*/\n"
+            "\n"
+            "#ifndef PESOS_AVALIACAO_H\n"
+            "#define PESOS_AVALIACAO_H\n"
+            "\n"
+            "#define PESO_JANELA_DOIS %d // Janela com 2 peças de um jogador e 2 casas vazias\n"
+            "#define PESO_JANELA_TRES %d // Janela com 3 peças de um jogador e 1 casa vazia\n"
+            "\n"
+            "#endif\n",
+            num_partidas, num_amostras, erro,
+            (int)lround(pesos[CARAC_JANELAS_DOIS] * ESCALA_PESOS), (int)lround(pesos[CARAC_JANELAS_TRES] * ESCALA_PESOS));
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int num_partidas = argc > 1 ? atoi(argv[1]) : PARTIDAS_PADRAO;
+    const char* saida = argc > 2 ? argv[2] : "pesos_avaliacao.h";
+    if (num_partidas <= 0) num_partidas = PARTIDAS_PADRAO;
+
+    SDL_SetMainReady();
+    motor_inicializar();
+
+    int num_threads = SDL_GetCPUCount();
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > 64) num_threads = 64;
+
+    // 1. Autojogo em paralelo
+    Uint64 inicio = SDL_GetPerformanceCounter();
+    TarefaAutojogo tarefas[64] = {0};
+    SDL_Thread* threads[64];
+    for (int t = 0; t < num_threads; t++) {
+        tarefas[t].num_partidas = num_partidas / num_threads + (t < num_partidas % num_threads);
+        tarefas[t].semente = (uint64_t)time(NULL) * 2654435761u + (uint64_t)t * UINT64_C(0x9E3779B97F4A7C15);
+        threads[t] = SDL_CreateThread(thread_autojogo, "autojogo", &tarefas[t]);
+        if (!threads[t]) thread_autojogo(&tarefas[t]);
+    }
+
+    int num_amostras = 0;
+    for (int t = 0; t < num_threads; t++) {
+        if (threads[t]) SDL_WaitThread(threads[t], NULL);
+        num_amostras += tarefas[t].num_amostras;
+    }
+    Amostra* amostras = malloc(sizeof(Amostra) * (num_amostras ? num_amostras : 1));
+    if (!amostras) return 1;
+    int n = 0;
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < tarefas[t].num_amostras; i++) amostras[n++] = tarefas[t].amostras[i];
+        free(tarefas[t].amostras);
+    }
+    double segundos = (double)(SDL_GetPerformanceCounter() - inicio) / (double)SDL_GetPerformanceFrequency();
+    printf("Autojogo: %d partidas, %d posicoes em %.1f s (%d threads)\n", num_partidas, num_amostras, segundos, num_threads);
+    if (num_amostras == 0) return 1;
+
+    // 2. Regressão logística (Texel)
+    double pesos[NUM_CARACTERISTICAS];
+    pesos[CARAC_JANELAS_DOIS] = (double)PESO_JANELA_DOIS / ESCALA_PESOS; // Em pontos inteiros, como K
+    pesos[CARAC_JANELAS_TRES] = (double)PESO_JANELA_TRES / ESCALA_PESOS;
+    double k = ajustar_escala(amostras, num_amostras, pesos, num_threads);
+    printf("Escala da sigmoide: K = %.4f\n", k);
+
+    double gradiente[NUM_CARACTERISTICAS];
+    double erro = 0.0;
+    for (int it = 0; it < ITERACOES_GRADIENTE; it++) {
+        erro = calcular_gradiente(amostras, num_amostras, pesos, k, num_threads, gradiente);
+        for (int i = 0; i < NUM_CARACTERISTICAS; i++) pesos[i] -= TAXA_APRENDIZADO / k * gradiente[i];
+        if (it % 500 == 0) printf("iteracao %4d: erro %.6f pesos %.3f %.3f\n", it, erro, pesos[0], pesos[1]);
+    }
+    printf("Pesos finais: dois %.3f tres %.3f (erro %.6f)\n", pesos[0], pesos[1], erro);
+
+    // 3. Cabeçalho gerado
+    bool ok = escrever_pesos(saida, pesos, num_partidas, num_amostras, erro);
+    printf(ok ? "Pesos escritos em %s\n" : "Falha ao escrever %s\n", saida);
+    free(amostras);
+    return ok ? 0 : 1;
+}